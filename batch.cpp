@@ -0,0 +1,337 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+// ----------------------------------------------------------------------------------------------
+// Batch parameter sweeps: render plugin.h offline for every combination of parameter values
+    // each job is an independent PluginState created from the same loaded plugin library,
+    // jobs are handed out to 1 worker thread per core, nothing is shared between jobs whilst rendering
+//
+// Sweep format, one setting or axis per line, '#' starts a comment:
+    // frames 48000             number of frames to render per job
+    // settle 4096              frames rendered & discarded first, so smoothed parameters reach the job's values (default)
+    // rate 48000               sampleRate (default --rate)
+    // block 256                frames per processPlugin() call (default --block)
+    // output results.csv       feature table, relative to the sweep file (default <sweep>.csv)
+    // wavs renders             optional folder for 1 .wav per job, relative to the sweep file
+    // threads 0                worker threads, 0 = 1 per core (default)
+    // sweep freq 100 1000 10   <param> <from> <to> <steps>, evenly spaced
+    // values saturate 0 1      <param> <value> .., also used to fix a parameter for every job
+//
+// The plugin's data files (ir.wav) are read from the sweep file's folder
+// The CSV has 1 row per job: job, the swept parameters, rms, peak & spectral centroid (Hz) of the mono mix
+// ----------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch.h"
+#include "fft.h"
+#include "render.h"
+#include "wavEncoder.h"
+
+constexpr int CENTROIDFFTSIZE = 2048;
+constexpr int SETTLEFRAMES = 4096; // plugin.h's smoothing glides from its defaults for a few hundred frames
+
+struct SweepAxis
+{
+    int param = 0; // index into PARAMNAMES
+    std::vector<float> values;
+};
+
+struct BatchSweep
+{
+    int numFrames = 0;
+    int settleFrames = SETTLEFRAMES;
+    int sampleRate = SAMPLERATE;
+    int blockSize = BUFFERFRAMES;
+    int numThreads = 0;
+    std::string outputPath = "";
+    std::string wavFolder = "";
+    std::vector<SweepAxis> axes;
+
+    std::size_t numJobs() const
+    {
+        std::size_t jobs = 1;
+        for (const SweepAxis& axis : axes) jobs *= axis.values.size();
+        return jobs;
+    }
+    // job index --> 1 value per axis, the last axis changes fastest
+    void jobValues(std::size_t job, std::vector<float>& values) const
+    {
+        values.resize(axes.size());
+        for (int a = static_cast<int>(axes.size()) - 1; a >= 0; a--)
+        {
+            values[a] = axes[a].values[job % axes[a].values.size()];
+            job /= axes[a].values.size();
+        }
+    }
+};
+
+struct JobFeatures
+{
+    float rms = 0.f;
+    float peak = 0.f;
+    float centroid = 0.f; // Hz
+    bool written = true;  // .wav, when requested
+};
+
+static bool parseSweep(const std::string& path, BatchSweep& sweep, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        error = "can't open " + path;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        std::istringstream words(line.substr(0, line.find('#')));
+        std::string first;
+        if (!(words >> first)) continue; // blank or comment
+
+        bool ok = true;
+        if (first == "frames") ok = static_cast<bool>(words >> sweep.numFrames) && sweep.numFrames > 0;
+        else if (first == "settle") ok = static_cast<bool>(words >> sweep.settleFrames) && sweep.settleFrames >= 0;
+        else if (first == "rate") ok = static_cast<bool>(words >> sweep.sampleRate) && sweep.sampleRate > 0;
+        else if (first == "block") ok = static_cast<bool>(words >> sweep.blockSize) && sweep.blockSize > 0 && sweep.blockSize <= static_cast<int>(MAXBUFFERFRAMES);
+        else if (first == "output") ok = static_cast<bool>(words >> sweep.outputPath);
+        else if (first == "wavs") ok = static_cast<bool>(words >> sweep.wavFolder);
+        else if (first == "threads") ok = static_cast<bool>(words >> sweep.numThreads) && sweep.numThreads >= 0;
+        else if (first == "sweep" || first == "values")
+        {
+            SweepAxis axis;
+            std::string name;
+            ok = static_cast<bool>(words >> name);
+            axis.param = UiParams::find(name);
+            if (ok && axis.param < 0)
+            {
+                error = path + ":" + std::to_string(lineNumber) + ": unknown parameter '" + name + "'";
+                return false;
+            }
+            if (first == "sweep")
+            {
+                float from = 0.f, to = 0.f;
+                int steps = 0;
+                ok = ok && static_cast<bool>(words >> from >> to >> steps) && steps > 0;
+                for (int i = 0; ok && i < steps; i++) axis.values.push_back(steps == 1 ? from : from + (to - from) * i / (steps - 1));
+            }
+            else
+            {
+                float value = 0.f;
+                while (words >> value) axis.values.push_back(value);
+                ok = ok && !axis.values.empty();
+            }
+            sweep.axes.push_back(axis);
+        }
+        else ok = false;
+        if (!ok)
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": can't parse '" + line + "'";
+            return false;
+        }
+    }
+    if (sweep.numFrames == 0 || sweep.axes.empty())
+    {
+        error = path + ": needs a 'frames' line and at least 1 'sweep' or 'values' line";
+        return false;
+    }
+    // outputs live next to their sweep file
+    std::filesystem::path folder = std::filesystem::path(path).parent_path();
+    if (sweep.outputPath.empty()) sweep.outputPath = std::filesystem::path(path).replace_extension(".csv").string();
+    else sweep.outputPath = (folder / sweep.outputPath).string();
+    if (!sweep.wavFolder.empty()) sweep.wavFolder = (folder / sweep.wavFolder).string();
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+// Per thread feature extraction, buffers are reused from job to job
+// ----------------------------------------------------------------------------------------------
+class FeatureExtractor
+{
+    public:
+        FeatureExtractor()
+        {
+            _fft.setSize(CENTROIDFFTSIZE);
+            _window.resize(CENTROIDFFTSIZE);
+            for (int n = 0; n < CENTROIDFFTSIZE; n++) _window[n] = 0.5f - 0.5f * cosf(TWOPI * n / CENTROIDFFTSIZE); // Hann
+            _frame.resize(CENTROIDFFTSIZE);
+            _re.resize(_fft.getNumBins());
+            _im.resize(_fft.getNumBins());
+            _magnitudes.resize(_fft.getNumBins());
+        }
+
+        // interleaved stereo in, features of the mono mix out
+        void extract(const std::vector<float>& render, int sampleRate, JobFeatures& features)
+        {
+            const int numFrames = static_cast<int>(render.size() / 2);
+            _mono.resize(numFrames);
+            double sumSquares = 0.0;
+            float peak = 0.f;
+            for (int i = 0; i < numFrames; i++)
+            {
+                _mono[i] = 0.5f * (render[2*i+0] + render[2*i+1]);
+                sumSquares += static_cast<double>(_mono[i]) * _mono[i];
+                peak = std::max(peak, std::fabs(_mono[i]));
+            }
+            features.rms = numFrames ? static_cast<float>(std::sqrt(sumSquares / numFrames)) : 0.f;
+            features.peak = peak;
+
+            // centroid of the magnitude spectrum averaged over half overlapping frames
+            std::fill(_magnitudes.begin(), _magnitudes.end(), 0.f);
+            for (int start = 0; start < numFrames; start += CENTROIDFFTSIZE / 2)
+            {
+                for (int n = 0; n < CENTROIDFFTSIZE; n++) _frame[n] = start + n < numFrames ? _mono[start + n] * _window[n] : 0.f;
+                _fft.forward(_frame.data(), _re.data(), _im.data());
+                for (int k = 0; k < _fft.getNumBins(); k++) _magnitudes[k] += std::sqrt(_re[k] * _re[k] + _im[k] * _im[k]);
+            }
+            double weighted = 0.0;
+            double total = 0.0;
+            for (int k = 0; k < _fft.getNumBins(); k++)
+            {
+                weighted += static_cast<double>(k) * _magnitudes[k];
+                total += _magnitudes[k];
+            }
+            features.centroid = total > 0.0 ? static_cast<float>(weighted / total * sampleRate / CENTROIDFFTSIZE) : 0.f;
+        }
+
+    private:
+        RealFFT _fft;
+        std::vector<float> _window;
+        std::vector<float> _frame;
+        std::vector<float> _re;
+        std::vector<float> _im;
+        std::vector<float> _magnitudes;
+        std::vector<float> _mono;
+};
+
+static bool writeCsv(const BatchSweep& sweep, const std::vector<JobFeatures>& results)
+{
+    std::ofstream file(sweep.outputPath);
+    if (!file.is_open()) return false;
+    file << "job";
+    for (const SweepAxis& axis : sweep.axes) file << "," << PARAMNAMES[axis.param];
+    file << ",rms,peak,centroid\n";
+
+    std::vector<float> values;
+    char number[32];
+    for (std::size_t job = 0; job < results.size(); job++)
+    {
+        file << job;
+        sweep.jobValues(job, values);
+        for (float value : values)
+        {
+            std::snprintf(number, sizeof(number), ",%.9g", value);
+            file << number;
+        }
+        std::snprintf(number, sizeof(number), ",%.9g", results[job].rms);
+        file << number;
+        std::snprintf(number, sizeof(number), ",%.9g", results[job].peak);
+        file << number;
+        std::snprintf(number, sizeof(number), ",%.9g\n", results[job].centroid);
+        file << number;
+    }
+    return static_cast<bool>(file);
+}
+
+bool runBatch(const HostConfig& config)
+{
+    BatchSweep sweep;
+    sweep.sampleRate = config.sampleRate;
+    sweep.blockSize = config.bufferFrames;
+    std::string error;
+    if (!parseSweep(config.batchPath, sweep, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return false;
+    }
+    PluginModule module{};
+    std::string resourceDir = std::filesystem::path(config.batchPath).parent_path().string(); // e.g. ir.wav next to the sweep
+    if (!openPluginModule(module, error, 0, resourceDir.empty() ? "." : resourceDir))
+    {
+        std::printf("%s\n", error.c_str());
+        return false;
+    }
+    if (!sweep.wavFolder.empty()) std::filesystem::create_directories(sweep.wavFolder);
+
+    const std::size_t numJobs = sweep.numJobs();
+    int numThreads = sweep.numThreads ? sweep.numThreads : static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = static_cast<int>(std::clamp<std::size_t>(numThreads, 1, numJobs));
+    std::printf("Rendering %zu jobs of %d frames on %d threads\n", numJobs, sweep.numFrames, numThreads);
+
+    // workers claim the next job from a shared counter, so long & short jobs balance out
+        // each job only writes its own results slot
+    std::vector<JobFeatures> results(numJobs);
+    std::atomic<std::size_t> nextJob = 0;
+    std::atomic<std::size_t> jobsDone = 0;
+    auto worker = [&]()
+    {
+        FeatureExtractor extractor;
+        std::vector<float> render;
+        std::vector<float> values;
+        std::vector<ParamEvent> events;
+        std::size_t job;
+        while ((job = nextJob.fetch_add(1)) < numJobs)
+        {
+            sweep.jobValues(job, values);
+            events.clear();
+            for (std::size_t a = 0; a < sweep.axes.size(); a++) events.push_back({ 0, sweep.axes[a].param, values[a] });
+
+            UiParams params; // fresh defaults for every job
+            // the events land at frame 0, the settle frames cover the glide to them & are dropped before any features
+            renderPlugin(module, params, events, sweep.sampleRate, sweep.blockSize, sweep.settleFrames + sweep.numFrames, render);
+            render.erase(render.begin(), render.begin() + sweep.settleFrames * 2);
+            extractor.extract(render, sweep.sampleRate, results[job]);
+
+            if (!sweep.wavFolder.empty())
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "job_%06zu.wav", job);
+                results[job].written = writeWavFile((std::filesystem::path(sweep.wavFolder) / name).string(), render, 2, sweep.sampleRate);
+            }
+            jobsDone.fetch_add(1);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) threads.emplace_back(worker);
+    std::size_t reported = 0;
+    while (reported < numJobs)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::size_t done = jobsDone.load();
+        if (done == reported) continue;
+        reported = done;
+        std::printf("\r%zu / %zu jobs", reported, numJobs);
+        std::fflush(stdout);
+    }
+    for (std::thread& thread : threads) thread.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    closePluginModule(module);
+
+    // realtime factor = seconds of audio rendered per second of wall clock
+    double audioSeconds = static_cast<double>(numJobs) * (sweep.settleFrames + sweep.numFrames) / sweep.sampleRate;
+    std::printf("\r%zu jobs in %.2f s, %.1f jobs/s, %.0fx realtime\n", numJobs, elapsed.count(), numJobs / elapsed.count(), audioSeconds / elapsed.count());
+
+    int failedWavs = static_cast<int>(std::count_if(results.begin(), results.end(), [](const JobFeatures& r) { return !r.written; }));
+    if (failedWavs) std::printf("%d .wav files couldn't be written to %s\n", failedWavs, sweep.wavFolder.c_str());
+    if (!writeCsv(sweep, results))
+    {
+        std::printf("Can't write %s\n", sweep.outputPath.c_str());
+        return false;
+    }
+    std::printf("Features written to %s\n", sweep.outputPath.c_str());
+    return true;
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include "config.h"
+
+// render every parameter combination of a --batch sweep file across all cores & write their features to CSV
+    // returns false if the sweep file or plugin couldn't be loaded, progress & errors are printed to stdout
+bool runBatch(const HostConfig& config);
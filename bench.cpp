@@ -0,0 +1,157 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "oversampler.h"
+#include "convolver.h"
+#include "render.h"
+
+// time a block function over 'seconds' of audio, returns the average cost as a fraction of the block period
+template <typename BlockFn>
+static float timeBlocks(const HostConfig& config, float seconds, BlockFn&& processBlock)
+{
+    const int numBlocks = static_cast<int>(seconds * config.sampleRate / config.bufferFrames);
+    for (int b = 0; b < 16; b++) processBlock(b); // warm up caches & branch predictors
+
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < numBlocks; b++) processBlock(b);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double blockPeriod = static_cast<double>(config.bufferFrames) / config.sampleRate;
+    return static_cast<float>(elapsed.count() / numBlocks / blockPeriod);
+}
+
+// -----------------------------------------------------------------------------
+// Oversampling: cost & latency of each factor around a tanh waveshaper
+// -----------------------------------------------------------------------------
+static void benchOversampling(const HostConfig& config)
+{
+    std::printf("\nOversampling, tanh waveshaper, stereo\n");
+    std::printf("linear phase FIR half-band stages only, a minimum phase IIR cascade would trade phase for less latency\n");
+    std::printf("%8s %14s %12s %12s\n", "factor", "latency", "us/block", "% of block");
+
+    const int frames = config.bufferFrames;
+    std::vector<float> block(frames * 2);
+    for (int factor = 1; factor <= 8; factor *= 2)
+    {
+        Oversampler oversampler;
+        oversampler.prepare(frames);
+        oversampler.setFactor(factor);
+
+        float load = timeBlocks(config, 10.f, [&](int b)
+        {
+            // a fresh bright input each block, so the kernel can't be skipped
+            for (int i = 0; i < frames; i++) block[2*i+0] = block[2*i+1] = sinf(TWOPI * 5000.f * (b * frames + i) / config.sampleRate);
+            oversampler.process(block.data(), frames, [](float* samples, int numSamples, int)
+            {
+                for (int i = 0; i < numSamples; i++) samples[i] = tanhf(4.f * samples[i]);
+            });
+        });
+
+        float latency = oversampler.getLatency();
+        char latencyText[32];
+        std::snprintf(latencyText, sizeof(latencyText), "%.1f (%.2fms)", latency, 1000.f * latency / config.sampleRate);
+        std::printf("%7dx %14s %12.2f %11.2f%%\n", factor, latencyText,
+                    1e6f * load * frames / config.sampleRate, 100.f * load);
+    }
+    std::printf("pick the lowest factor whose aliasing you can't hear, the latency column is the FIR's group delay\n");
+}
+
+// -----------------------------------------------------------------------------
+// Convolution: a 5 second stereo reverb tail, split into audio thread & total cost
+// -----------------------------------------------------------------------------
+static void benchConvolution(const HostConfig& config)
+{
+    std::printf("\nConvolution, 5 s stereo impulse response, zero latency\n");
+    std::printf("%24s %12s %12s\n", "", "us/block", "% of 1 core");
+
+    // exponentially decaying noise, like a room
+    const int irLength = 5 * config.sampleRate;
+    std::vector<float> ir(irLength);
+    unsigned int seed = 1;
+    for (int i = 0; i < irLength; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = static_cast<float>(seed >> 8) / (1 << 24) * 2.f - 1.f;
+        ir[i] = noise * expf(-6.9f * i / irLength);
+    }
+
+    const int frames = config.bufferFrames;
+    std::vector<float> in(frames);
+    std::vector<float> out(frames);
+    // the audio thread only runs the direct head & the first FFT section, ie the IR up to the tail
+    const int headLength = std::min(irLength, 2 * Convolver::TAILRATIO * frames);
+    const char* names[2] = { "audio thread (head)", "total (head + tail)" };
+    const int lengths[2] = { headLength, irLength };
+    for (int i = 0; i < 2; i++)
+    {
+        Convolver convolvers[2];
+        for (Convolver& convolver : convolvers) convolver.prepare(ir.data(), lengths[i], frames, false); // tail inline so it's timed too
+
+        float load = timeBlocks(config, 10.f, [&](int b)
+        {
+            for (int n = 0; n < frames; n++) in[n] = sinf(TWOPI * 440.f * (b * frames + n) / config.sampleRate);
+            for (Convolver& convolver : convolvers) convolver.process(in.data(), out.data(), frames);
+        });
+        std::printf("%24s %12.2f %11.2f%%\n", names[i], 1e6f * load * frames / config.sampleRate, 100.f * load);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Batch sweeps: the same offline renders as --batch on 1, 2, 4 .. threads
+// -----------------------------------------------------------------------------
+static void benchBatchScaling(const HostConfig& config)
+{
+    std::printf("\nBatch renders, 1 s jobs of plugin.h, saturate on, threads vs 1 thread\n");
+    PluginModule module{};
+    std::string error;
+    if (!openPluginModule(module, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return;
+    }
+    std::printf("%8s %12s %10s %12s\n", "threads", "jobs/s", "speedup", "efficiency");
+
+    const int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int jobsPerThread = 8;
+    const std::vector<ParamEvent> events = { { 0, UiParams::find("saturate"), 1.f } };
+    double singleRate = 0.0;
+    for (int numThreads = 1; ; numThreads = std::min(numThreads * 2, maxThreads))
+    {
+        // a fixed amount of work per thread, so perfect scaling keeps the wall clock constant
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++) threads.emplace_back([&]()
+        {
+            std::vector<float> render;
+            for (int job = 0; job < jobsPerThread; job++)
+            {
+                UiParams params;
+                renderPlugin(module, params, events, config.sampleRate, config.bufferFrames, config.sampleRate, render);
+            }
+        });
+        for (std::thread& thread : threads) thread.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double rate = numThreads * jobsPerThread / elapsed.count();
+        if (numThreads == 1) singleRate = rate;
+        std::printf("%8d %12.1f %9.2fx %11.0f%%\n", numThreads, rate, rate / singleRate, 100.0 * rate / singleRate / numThreads);
+        if (numThreads == maxThreads) break;
+    }
+    if (maxThreads == 1) std::printf("only 1 core available, nothing to scale across\n");
+    closePluginModule(module);
+}
+
+void runBenchmarks(const HostConfig& config)
+{
+    std::printf("DSPlayground benchmarks @ %d Hz, %d frames per block\n", config.sampleRate, config.bufferFrames);
+    benchOversampling(config);
+    benchConvolution(config);
+    benchBatchScaling(config);
+}
@@ -0,0 +1,9 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include "config.h"
+
+// offline benchmarks at the configured sampleRate & block size, printed to stdout
+void runBenchmarks(const HostConfig& config);
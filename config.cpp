@@ -0,0 +1,242 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "config.h"
+
+// strip leading and trailing whitespace
+static std::string trim(const std::string& text)
+{
+    std::size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    std::size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+static bool parseInt(const std::string& text, int& value)
+{
+    try
+    {
+        std::size_t used = 0;
+        value = std::stoi(text, &used);
+        return used == text.size();
+    }
+    catch (...) { return false; }
+}
+
+// apply a single setting, shared by the config file and command line parsers
+static bool applySetting(const std::string& key, const std::string& value, HostConfig& config, std::string& error)
+{
+    int number = 0;
+    if (key == "session")
+    {
+        config.sessionPath = value;
+        return true;
+    }
+    if (key == "remote")
+    {
+        config.remotePath = value;
+        return true;
+    }
+    if (key == "device")
+    {
+        config.device = value;
+        config.explicitDevice = true;
+        return true;
+    }
+    if (key != "rate" && key != "block" && key != "record" && key != "instances" && key != "arena" && key != "deadline" && key != "misses")
+    {
+        error = "unknown setting '" + key + "'";
+        return false;
+    }
+    if (!parseInt(value, number))
+    {
+        error = "'" + key + "' expects a whole number, got '" + value + "'";
+        return false;
+    }
+    if (key == "instances")
+    {
+        if (number < 1 || number > MAXINSTANCES)
+        {
+            error = "instances must be between 1 and " + std::to_string(MAXINSTANCES);
+            return false;
+        }
+        config.instances = number;
+        return true;
+    }
+    if (key == "arena")
+    {
+        if (number < 1 || number > 1024)
+        {
+            error = "arena must be between 1 and 1024 MB";
+            return false;
+        }
+        config.arenaMb = number;
+        return true;
+    }
+    if (key == "deadline")
+    {
+        if (number < 0 || number > 100)
+        {
+            error = "deadline must be between 0 (off) and 100 % of the block period";
+            return false;
+        }
+        config.deadlinePercent = number;
+        return true;
+    }
+    if (key == "misses")
+    {
+        if (number < 1 || number > 1000)
+        {
+            error = "misses must be between 1 and 1000 blocks";
+            return false;
+        }
+        config.missLimit = number;
+        return true;
+    }
+    if (key == "rate")
+    {
+        if (number < static_cast<int>(MINSAMPLERATE) || number > static_cast<int>(MAXSAMPLERATE))
+        {
+            error = "rate must be between " + std::to_string(MINSAMPLERATE) + " and " + std::to_string(MAXSAMPLERATE);
+            return false;
+        }
+        config.sampleRate = number;
+        config.explicitSampleRate = true;
+    }
+    else if (key == "block")
+    {
+        if (number < static_cast<int>(MINBUFFERFRAMES) || number > static_cast<int>(MAXBUFFERFRAMES))
+        {
+            error = "block must be between " + std::to_string(MINBUFFERFRAMES) + " and " + std::to_string(MAXBUFFERFRAMES);
+            return false;
+        }
+        config.bufferFrames = number;
+        config.explicitBufferFrames = true;
+    }
+    else // record
+    {
+        if (number < 1 || number > 60)
+        {
+            error = "record must be between 1 and 60 seconds";
+            return false;
+        }
+        config.recordDuration = number;
+        config.explicitRecordDuration = true;
+    }
+    return true;
+}
+
+bool loadConfigFile(const std::string& path, HostConfig& config, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        error = "can't open config file " + path;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#'))); // drop comments
+        if (line.empty()) continue;
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos)
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": expected 'key = value'";
+            return false;
+        }
+        std::string settingError;
+        if (!applySetting(trim(line.substr(0, equals)), trim(line.substr(equals + 1)), config, settingError))
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": " + settingError;
+            return false;
+        }
+    }
+    for (const auto& [key, value] : config.flagSettings) applySetting(key, value, config, error); // already validated by parseArgs()
+    return true;
+}
+
+bool parseArgs(int argc, char** argv, HostConfig& config, std::string& error)
+{
+    // apply the config file first so command line flags take priority
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string(argv[i]) == "--config") config.configPath = argv[i + 1];
+    }
+    if (!config.configPath.empty() && !loadConfigFile(config.configPath, config, error)) return false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string flag = argv[i];
+        if (flag == "--help" || flag == "-h") return false; // empty error, just print usage
+        if (flag == "--list-devices")
+        {
+            config.listDevices = true;
+            continue;
+        }
+        if (flag == "--headless")
+        {
+            config.headless = true;
+            continue;
+        }
+        if (flag == "--bench")
+        {
+            config.bench = true;
+            continue;
+        }
+        if (flag == "--update-golden")
+        {
+            config.updateGolden = true;
+            continue;
+        }
+        if (flag.rfind("--", 0) != 0 || i + 1 >= argc)
+        {
+            error = "unexpected argument '" + flag + "'";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (flag == "--config") continue; // already applied
+        if (flag == "--test")
+        {
+            config.testScripts.push_back(value);
+            continue;
+        }
+        if (flag == "--batch")
+        {
+            config.batchPath = value;
+            continue;
+        }
+        if (!applySetting(flag.substr(2), value, config, error)) return false;
+        config.flagSettings.emplace_back(flag.substr(2), value);
+    }
+    return true;
+}
+
+void printUsage(const char* programName)
+{
+    std::cerr << "Usage: " << programName << " [options]\n"
+              << "  --device <id|name>   output device, see --list-devices (default: system default)\n"
+              << "  --rate <hz>          sampleRate, " << MINSAMPLERATE << "-" << MAXSAMPLERATE << " (default: " << SAMPLERATE << ")\n"
+              << "  --block <frames>     frames per callback, " << MINBUFFERFRAMES << "-" << MAXBUFFERFRAMES << " (default: " << BUFFERFRAMES << ")\n"
+              << "  --record <seconds>   length of .wav recordings (default: " << RECORDDURATION << ")\n"
+              << "  --instances <n>      plugin instances mixed to the output, 1-" << MAXINSTANCES << " (default: 1)\n"
+              << "  --arena <mb>         pre-faulted realtime memory per instance for plugin buffers (default: " << ARENAMB << ")\n"
+              << "  --deadline <percent> plugin time limit per block, 0 = no watchdog (default: " << DEADLINEPERCENT << ")\n"
+              << "  --misses <blocks>    missed deadlines in a row before falling back to the previous plugin (default: " << MISSLIMIT << ")\n"
+              << "  --config <file>      'key = value' settings file, edits are applied whilst running\n"
+              << "  --session <file>     session snapshot to restore & save (default: session.dsps)\n"
+              << "  --remote <socket>    listen for remote control messages on a UNIX socket, see remote.cpp\n"
+              << "  --headless           no terminal UI, log to standard output\n"
+              << "  --list-devices       print output devices and exit\n"
+              << "  --test <script>      render plugin.h offline & compare with the script's golden .wav, repeatable\n"
+              << "  --update-golden      with --test, rewrite the golden files instead\n"
+              << "  --batch <sweep>      render every parameter combination of a sweep file on all cores, see batch.cpp\n"
+              << "  --bench              print the cost & latency of DSP building blocks at --rate/--block and exit\n";
+}
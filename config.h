@@ -0,0 +1,46 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "globals.h"
+
+// -----------------------------------------------------------------------------
+// Host settings chosen at runtime, from command line flags and/or a config file
+// -----------------------------------------------------------------------------
+struct HostConfig
+{
+    std::string device = "";                // output device id or (part of) its name, empty = system default
+    int sampleRate = SAMPLERATE;            // requested stream sampleRate
+    int bufferFrames = BUFFERFRAMES;        // requested frames per callback, RtAudio may change it
+    int recordDuration = RECORDDURATION;    // number of seconds to record
+    int instances = 1;                      // plugin instances mixed to the output, instance 0 follows the UI
+    int arenaMb = ARENAMB;                  // pre-faulted realtime memory per plugin instance, in MB
+    int deadlinePercent = DEADLINEPERCENT;  // plugin time limit as a % of the block period, 0 = no watchdog
+    int missLimit = MISSLIMIT;              // deadline misses in a row before the plugin is switched off
+    std::string configPath = "";            // optional config file, watched for changes whilst running
+    std::string sessionPath = "session.dsps"; // session snapshot restored at startup & saved from the UI
+    std::string remotePath = "";            // UNIX socket for the remote control server, empty = off
+    bool headless = false;                  // no terminal UI, log to standard output (for scripts & remote control)
+    bool explicitDevice = false;            // given by flag or config file, each one takes priority over the session's value
+    bool explicitSampleRate = false;
+    bool explicitBufferFrames = false;
+    bool explicitRecordDuration = false;
+    bool listDevices = false;               // print output devices and exit
+    bool bench = false;                     // run offline benchmarks and exit
+    std::vector<std::string> testScripts;   // golden output test scripts to run, then exit
+    bool updateGolden = false;              // rewrite golden files instead of comparing against them
+    std::string batchPath = "";             // parameter sweep to render offline across all cores, then exit
+    std::vector<std::pair<std::string, std::string>> flagSettings; // settings given as command line flags, they win over every config file reload
+};
+
+// parse "key = value" lines, '#' starts a comment. Keys match the long flag names (device, rate, block, record, instances, arena, deadline, misses, session, remote)
+    // config.flagSettings are applied again afterwards, so reloading the file whilst running never overrides a flag
+bool loadConfigFile(const std::string& path, HostConfig& config, std::string& error);
+// parse command line flags, a --config file is applied first so flags override it
+    // returns false with an empty error for --help
+bool parseArgs(int argc, char** argv, HostConfig& config, std::string& error);
+void printUsage(const char* programName);
@@ -0,0 +1,352 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <pthread.h>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "fft.h"
+
+// ----------------------------------------------------------------------------------------------
+// Uniformly partitioned overlap-save convolution of one section of an impulse response
+    // input spectra are kept in a frequency-domain delay line (FDL), so each new block costs
+    // 1 forward FFT, 1 complex multiply-accumulate per partition & 1 inverse FFT
+// ----------------------------------------------------------------------------------------------
+class PartitionedStage
+{
+    public:
+        // split taps [firstPartition * partitionSize, lastTap) into partitions of partitionSize taps
+        void prepare(const float* ir, int partitionSize, int firstPartition, int lastTap)
+        {
+            _partitionSize = partitionSize;
+            _fft.setSize(2 * partitionSize);
+            _numBins = _fft.getNumBins();
+
+            const int firstTap = firstPartition * partitionSize;
+            _numPartitions = std::max(0, (lastTap - firstTap + partitionSize - 1) / partitionSize);
+            _irRe.assign(_numPartitions * _numBins, 0.f);
+            _irIm.assign(_numPartitions * _numBins, 0.f);
+            _fdlRe.assign(_numPartitions * _numBins, 0.f);
+            _fdlIm.assign(_numPartitions * _numBins, 0.f);
+            _accRe.assign(_numBins, 0.f);
+            _accIm.assign(_numBins, 0.f);
+            _timeDomain.assign(2 * partitionSize, 0.f);
+            _head = 0;
+
+            // partition spectra, each zero padded to the FFT size
+            for (int p = 0; p < _numPartitions; p++)
+            {
+                std::fill(_timeDomain.begin(), _timeDomain.end(), 0.f);
+                for (int k = 0; k < partitionSize; k++)
+                {
+                    int tap = firstTap + p * partitionSize + k;
+                    if (tap < lastTap) _timeDomain[k] = ir[tap];
+                }
+                _fft.forward(_timeDomain.data(), &_irRe[p * _numBins], &_irIm[p * _numBins]);
+            }
+        }
+
+        // window = the last 2 input blocks (2 * partitionSize samples, oldest first)
+            // writes partitionSize samples of output for the block firstPartition blocks after the newest input block
+        void process(const float* window, float* out)
+        {
+            _head = (_head + 1) % _numPartitions;
+            _fft.forward(window, &_fdlRe[_head * _numBins], &_fdlIm[_head * _numBins]);
+
+            float* __restrict accRe = _accRe.data();
+            float* __restrict accIm = _accIm.data();
+            std::fill_n(accRe, _numBins, 0.f);
+            std::fill_n(accIm, _numBins, 0.f);
+            for (int p = 0; p < _numPartitions; p++)
+            {
+                // partition p meets the input from p blocks ago
+                const int slot = (_head - p + _numPartitions) % _numPartitions;
+                const float* __restrict hRe = &_irRe[p * _numBins];
+                const float* __restrict hIm = &_irIm[p * _numBins];
+                const float* __restrict xRe = &_fdlRe[slot * _numBins];
+                const float* __restrict xIm = &_fdlIm[slot * _numBins];
+                for (int k = 0; k < _numBins; k++)
+                {
+                    accRe[k] += hRe[k] * xRe[k] - hIm[k] * xIm[k];
+                    accIm[k] += hRe[k] * xIm[k] + hIm[k] * xRe[k];
+                }
+            }
+            _fft.inverse(accRe, accIm, _timeDomain.data());
+
+            // overlap-save: only the second half is free of circular wrap around
+            std::copy(_timeDomain.begin() + _partitionSize, _timeDomain.end(), out);
+        }
+
+        int getNumPartitions() const { return _numPartitions; }
+
+    private:
+        RealFFT _fft;
+        int _partitionSize = 0;
+        int _numBins = 0;
+        int _numPartitions = 0;
+        int _head = 0;                  // FDL slot holding the newest input spectrum
+        std::vector<float> _irRe;       // [partition * numBins + bin]
+        std::vector<float> _irIm;
+        std::vector<float> _fdlRe;      // [slot * numBins + bin], ring of input spectra
+        std::vector<float> _fdlIm;
+        std::vector<float> _accRe;
+        std::vector<float> _accIm;
+        std::vector<float> _timeDomain;
+};
+
+// ----------------------------------------------------------------------------------------------
+// Zero latency, non-uniformly partitioned convolution for long impulse responses (reverbs, cabinets)
+    // taps [0, B)      direct form FIR, so output starts on the same sample as the input
+    // taps [B, 2T)     FFT partitions of B = blockSize taps, computed on the audio thread
+    // taps [2T, end)   FFT partitions of T = 16 * B taps, computed on a background thread
+    //                  which gets a whole T block of time as the tail starts 2 T blocks late
+    //                  the thread is only started by startWorker() & runs 1 priority step below process()'s thread
+    // mono, use 1 per channel. prepare() allocates, process() never does & takes any numFrames
+// ----------------------------------------------------------------------------------------------
+class Convolver
+{
+    public:
+        static constexpr int TAILRATIO = 16; // tail partition size / head partition size
+
+        ~Convolver() { stopWorker(); }
+
+        // backgroundTail = false computes the tail inline instead, for deterministic offline renders
+            // otherwise the tail stays silent until startWorker()
+        void prepare(const float* ir, int irLength, int blockSize, bool backgroundTail = true)
+        {
+            stopWorker();
+
+            _blockSize = 16;
+            while (_blockSize < blockSize) _blockSize *= 2;
+            _tailSize = _blockSize * TAILRATIO;
+
+            _directTaps.assign(ir, ir + std::min(irLength, _blockSize));
+            _window.assign(2 * _blockSize, 0.f);
+            _pos = 0;
+
+            const int uniformEnd = std::min(irLength, 2 * _tailSize);
+            _hasUniform = uniformEnd > _blockSize;
+            if (_hasUniform) _uniform.prepare(ir, _blockSize, 1, uniformEnd);
+            _uniformOut.assign(_blockSize, 0.f);
+
+            _hasTail = irLength > 2 * _tailSize;
+            if (_hasTail)
+            {
+                _tail.prepare(ir, _tailSize, 2, irLength);
+                _tailWindow.assign(2 * _tailSize, 0.f);
+                _tailInput.assign(TAILSLOTS * _tailSize, 0.f);
+                _tailOutput.assign(TAILSLOTS * _tailSize, 0.f);
+                _tailPos = 0;
+                _tailBlock = 0;
+                _tailActive = true; // the first 2 tail blocks are silent anyway
+                _tailRequested.store(-1);
+                _tailDone.store(-1);
+                _tailMisses.store(0);
+                _backgroundTail = backgroundTail;
+            }
+        }
+
+        // start the background tail thread, off the audio thread as it allocates. Does nothing if it's running or not needed
+            // separate from prepare() so instances that never convolve don't keep an idle thread each
+        void startWorker()
+        {
+            if (!_hasTail || !_backgroundTail || _worker.joinable()) return;
+            _quit.store(false);
+            _callerPolicy.store(-1);
+            _priorityApplied = false;
+            _worker = std::thread([this] { workerLoop(); });
+            _workerRunning.store(true, std::memory_order_release);
+        }
+
+        void process(const float* in, float* out, int numFrames)
+        {
+            int done = 0;
+            while (done < numFrames)
+            {
+                // never cross a head block boundary (& so never a tail block boundary either)
+                const int chunk = std::min(numFrames - done, _blockSize - _pos);
+                float* current = _window.data() + _blockSize + _pos;
+                std::copy(in + done, in + done + chunk, current);
+
+                // direct form head, tap by tap across the chunk so the inner loop vectorises
+                float* __restrict o = out + done;
+                std::fill_n(o, chunk, 0.f);
+                for (int k = 0; k < static_cast<int>(_directTaps.size()); k++)
+                {
+                    const float c = _directTaps[k];
+                    const float* __restrict x = current - k;
+                    for (int n = 0; n < chunk; n++) o[n] += c * x[n];
+                }
+
+                if (_hasUniform)
+                {
+                    for (int n = 0; n < chunk; n++) o[n] += _uniformOut[_pos + n];
+                }
+
+                if (_hasTail)
+                {
+                    const int slot = static_cast<int>(_tailBlock % TAILSLOTS) * _tailSize + _tailPos;
+                    std::copy(in + done, in + done + chunk, &_tailInput[slot]);
+                    if (_tailActive)
+                    {
+                        for (int n = 0; n < chunk; n++) o[n] += _tailOutput[slot + n];
+                    }
+                    _tailPos += chunk;
+                }
+
+                _pos += chunk;
+                done += chunk;
+
+                // head block complete: compute the FFT section's output for the next block
+                if (_pos == _blockSize)
+                {
+                    if (_hasUniform) _uniform.process(_window.data(), _uniformOut.data());
+                    std::copy(_window.begin() + _blockSize, _window.end(), _window.begin());
+                    _pos = 0;
+                }
+
+                // tail block complete: hand it over & check the block about to start has its output
+                if (_hasTail && _tailPos == _tailSize)
+                {
+                    const std::int64_t finished = _tailBlock++;
+                    _tailPos = 0;
+                    if (!_backgroundTail) computeTail(finished);
+                    else if (_workerRunning.load(std::memory_order_acquire))
+                    {
+                        if (_callerPolicy.load(std::memory_order_relaxed) < 0) recordCallerPriority(); // once, for the worker to follow
+                        _tailRequested.store(finished, std::memory_order_release);
+                        _wake.release();
+                    }
+                    else skipTail(finished); // no worker yet
+
+                    _tailActive = _tailDone.load(std::memory_order_acquire) >= _tailBlock - 2;
+                    if (!_tailActive) _tailMisses.fetch_add(1); // worker overloaded, tail drops out for 1 block
+                }
+            }
+        }
+
+        // number of tail blocks skipped because the background thread was late
+        int getTailMisses() const { return _tailMisses.load(); }
+
+    private:
+        static constexpr int TAILSLOTS = 4; // ring of tail input / output blocks shared with the worker
+
+        // input tail block n --> output tail block n + 2
+        void computeTail(std::int64_t n)
+        {
+            std::copy(_tailWindow.begin() + _tailSize, _tailWindow.end(), _tailWindow.begin());
+            std::copy_n(&_tailInput[(n % TAILSLOTS) * _tailSize], _tailSize, _tailWindow.begin() + _tailSize);
+            _tail.process(_tailWindow.data(), &_tailOutput[((n + 2) % TAILSLOTS) * _tailSize]);
+            _tailDone.store(n, std::memory_order_release);
+        }
+
+        // keep the tail's input history but leave its output silent
+        void skipTail(std::int64_t n)
+        {
+            std::copy(_tailWindow.begin() + _tailSize, _tailWindow.end(), _tailWindow.begin());
+            std::copy_n(&_tailInput[(n % TAILSLOTS) * _tailSize], _tailSize, _tailWindow.begin() + _tailSize);
+            std::fill_n(&_tailOutput[((n + 2) % TAILSLOTS) * _tailSize], _tailSize, 0.f);
+            _tailDone.store(n, std::memory_order_release);
+        }
+
+        // scheduling of the thread calling process(), the audio thread or the host's plugin worker
+        void recordCallerPriority()
+        {
+            int policy;
+            sched_param param;
+            if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) policy = SCHED_OTHER;
+            _callerPriority.store(param.sched_priority, std::memory_order_relaxed);
+            _callerPolicy.store(policy, std::memory_order_release);
+        }
+
+        // realtime callers get a tail 1 step below them, so a late tail can never hold up the head
+            // anything else leaves the worker at the default priority
+        void applyCallerPriority()
+        {
+            const int policy = _callerPolicy.load(std::memory_order_acquire);
+            if (policy < 0) return;
+            _priorityApplied = true;
+            if (policy != SCHED_FIFO && policy != SCHED_RR) return;
+            sched_param param{};
+            param.sched_priority = _callerPriority.load(std::memory_order_relaxed) - 1;
+            if (param.sched_priority >= sched_get_priority_min(policy)) pthread_setschedparam(pthread_self(), policy, &param); // best effort
+        }
+
+        void workerLoop()
+        {
+            while (true)
+            {
+                _wake.acquire();
+                if (_quit.load()) return;
+                if (!_priorityApplied) applyCallerPriority();
+                // catch up on every block requested so far, in order
+                while (_tailDone.load() < _tailRequested.load(std::memory_order_acquire)) computeTail(_tailDone.load() + 1);
+            }
+        }
+
+        void stopWorker()
+        {
+            if (!_worker.joinable()) return;
+            _quit.store(true);
+            _wake.release();
+            _worker.join();
+            _workerRunning.store(false);
+        }
+
+        int _blockSize = 0;                 // B, head partition size
+        int _tailSize = 0;                  // T, tail partition size
+        int _pos = 0;                       // position within the current head block
+        std::vector<float> _directTaps;
+        std::vector<float> _window;         // previous + current head block, doubles as the direct FIR's history
+
+        bool _hasUniform = false;
+        PartitionedStage _uniform;
+        std::vector<float> _uniformOut;     // FFT section output for the current head block
+
+        bool _hasTail = false;
+        bool _backgroundTail = true;
+        bool _tailActive = true;
+        int _tailPos = 0;                   // position within the current tail block
+        std::int64_t _tailBlock = 0;        // index of the current tail block
+        PartitionedStage _tail;
+        std::vector<float> _tailWindow;     // worker only
+        std::vector<float> _tailInput;      // [slot * T + sample]
+        std::vector<float> _tailOutput;     // [slot * T + sample]
+        std::atomic<std::int64_t> _tailRequested = -1;
+        std::atomic<std::int64_t> _tailDone = -1;
+        std::atomic<int> _tailMisses = 0;
+        std::atomic<bool> _quit = false;
+        std::atomic<bool> _workerRunning = false;   // set by startWorker(), until then process() skips the tail
+        std::atomic<int> _callerPolicy = -1;        // process() thread's scheduling, -1 until the first tail hand over
+        std::atomic<int> _callerPriority = 0;
+        bool _priorityApplied = false;              // worker only
+        std::counting_semaphore<> _wake{0};
+        std::thread _worker;
+};
+
+// ----------------------------------------------------------------------------------------------
+// De-interleave 1 channel of an impulse response & linearly resample it to the stream's sampleRate
+    // channels beyond the file's channel count reuse its last channel, so mono IRs work on stereo plugins
+// ----------------------------------------------------------------------------------------------
+inline std::vector<float> extractImpulseResponse(const std::vector<float>& interleaved, int numChannels, int channel, int fromRate, int toRate)
+{
+    channel = std::min(channel, numChannels - 1);
+    const int frames = static_cast<int>(interleaved.size()) / numChannels;
+    const double step = static_cast<double>(fromRate) / toRate;
+    std::vector<float> ir(static_cast<std::size_t>(frames / step));
+    for (std::size_t i = 0; i < ir.size(); i++)
+    {
+        double position = i * step;
+        int index = static_cast<int>(position);
+        float frac = static_cast<float>(position - index);
+        float a = interleaved[index * numChannels + channel];
+        float b = index + 1 < frames ? interleaved[(index + 1) * numChannels + channel] : 0.f;
+        ir[i] = a + frac * (b - a);
+    }
+    return ir;
+}
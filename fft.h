@@ -0,0 +1,124 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "globals.h"
+
+// ----------------------------------------------------------------------------------------------
+// Real-input FFT of a power of 2 size, computed as a half size complex FFT
+    // spectra are split into separate real & imaginary arrays of size/2 + 1 bins,
+    // so multiply-accumulates over bins are simple loops the compiler can vectorise
+    // tables & work buffers are allocated in setSize(), forward() / inverse() never allocate
+// ----------------------------------------------------------------------------------------------
+class RealFFT
+{
+    public:
+        void setSize(int size)
+        {
+            _size = size;
+            _half = size / 2;
+            _bitReverse.assign(_half, 0);
+            _twiddles.assign(_half / 2 + 1, {});
+            _realTwiddles.assign(_half + 1, {});
+            _work.assign(_half, {});
+
+            int bits = 0;
+            while ((1 << bits) < _half) bits++;
+            for (int i = 0; i < _half; i++)
+            {
+                int reversed = 0;
+                for (int b = 0; b < bits; b++) reversed |= ((i >> b) & 1) << (bits - 1 - b);
+                _bitReverse[i] = reversed;
+            }
+            for (int k = 0; k <= _half / 2; k++) _twiddles[k] = std::polar(1.f, -TWOPI * k / _half);
+            for (int k = 0; k <= _half; k++) _realTwiddles[k] = std::polar(1.f, -TWOPI * k / _size);
+        }
+        int getSize() const { return _size; }
+        int getNumBins() const { return _half + 1; }
+
+        // size real samples --> size/2 + 1 complex bins
+        void forward(const float* in, float* re, float* im)
+        {
+            // pack even / odd samples as real / imaginary parts
+            for (int n = 0; n < _half; n++) _work[_bitReverse[n]] = { in[2*n+0], in[2*n+1] };
+            transform(false);
+
+            // untangle the two interleaved real spectra
+            for (int k = 0; k <= _half; k++)
+            {
+                std::complex<float> a = _work[k == _half ? 0 : k];
+                std::complex<float> b = std::conj(_work[k == 0 ? 0 : _half - k]);
+                std::complex<float> even = 0.5f * (a + b);
+                std::complex<float> odd = std::complex<float>(0.f, -0.5f) * (a - b);
+                std::complex<float> bin = even + multiply(_realTwiddles[k], odd);
+                re[k] = bin.real();
+                im[k] = bin.imag();
+            }
+        }
+
+        // size/2 + 1 complex bins --> size real samples, scaled so inverse(forward(x)) == x
+        void inverse(const float* re, const float* im, float* out)
+        {
+            const float scale = 1.f / _half;
+            for (int k = 0; k < _half; k++)
+            {
+                std::complex<float> a = { re[k], im[k] };
+                std::complex<float> b = { re[_half - k], -im[_half - k] };
+                std::complex<float> even = 0.5f * (a + b);
+                std::complex<float> odd = multiply(0.5f * (a - b), std::conj(_realTwiddles[k]));
+                _work[_bitReverse[k]] = even + std::complex<float>(0.f, 1.f) * odd;
+            }
+            transform(true);
+            for (int n = 0; n < _half; n++)
+            {
+                out[2*n+0] = _work[n].real() * scale;
+                out[2*n+1] = _work[n].imag() * scale;
+            }
+        }
+
+    private:
+        // iterative radix-2 complex FFT on bit reversed input, in place
+        void transform(bool inverse)
+        {
+            for (int length = 2; length <= _half; length *= 2)
+            {
+                const int halfLength = length / 2;
+                const int stride = _half / length;
+                for (int start = 0; start < _half; start += length)
+                {
+                    for (int j = 0; j < halfLength; j++)
+                    {
+                        std::complex<float> w = twiddle(j * stride);
+                        if (inverse) w = std::conj(w);
+                        std::complex<float> t = multiply(w, _work[start + j + halfLength]);
+                        _work[start + j + halfLength] = _work[start + j] - t;
+                        _work[start + j] += t;
+                    }
+                }
+            }
+        }
+
+        // plain complex multiply, std::complex's operator* adds slow inf / nan recovery without -ffast-math
+        static std::complex<float> multiply(std::complex<float> a, std::complex<float> b)
+        {
+            return { a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() };
+        }
+
+        // exp(-2*pi*i*k/half) for k < half, from a table covering half the circle
+        std::complex<float> twiddle(int k) const
+        {
+            if (k <= _half / 2) return _twiddles[k];
+            return -_twiddles[k - _half / 2];
+        }
+
+        int _size = 0;
+        int _half = 0;
+        std::vector<int> _bitReverse;
+        std::vector<std::complex<float>> _twiddles;
+        std::vector<std::complex<float>> _realTwiddles;
+        std::vector<std::complex<float>> _work;
+};
@@ -4,18 +4,32 @@
 #pragma once
 
 #include <atomic>
+#include <string>
 #include <vector>
 #include "ftxui/dom/elements.hpp"
+#include "spscQueue.h"
 
 // constants
+    // defaults only, override at runtime with command line flags or a config file (see config.h)
 constexpr std::size_t SAMPLERATE = 48000; // should be a sampleRate supported by RTaudio and your soundcard
 constexpr std::size_t BUFFERFRAMES = 256; // number of frames per audio callback
 constexpr std::size_t RECORDDURATION = 3; // number of seconds to record
-constexpr std::size_t RECORDFRAMES = SAMPLERATE * RECORDDURATION; // number of frames to record
+constexpr std::size_t MINSAMPLERATE = 44100; // lowest selectable sampleRate
+constexpr std::size_t MAXSAMPLERATE = 192000; // highest selectable sampleRate, buffers are sized for this
+constexpr std::size_t MINBUFFERFRAMES = 16; // smallest selectable block size
+constexpr std::size_t MAXBUFFERFRAMES = 4096; // largest selectable block size
+constexpr int MAXINSTANCES = 64; // plugin instances hosted at once, see --instances
+constexpr int ARENAMB = 1; // default RealtimeArena size per plugin instance, see --arena. plugin.h needs ~64 KB at 4096 frames
+constexpr int DEADLINEPERCENT = 80; // default plugin time limit as a % of the block period, see --deadline
+constexpr int MISSLIMIT = 3; // default deadline misses in a row before a plugin is switched off, see --misses
+constexpr int LOADTIMEOUT = 10; // seconds a new build gets for initModule(), createPlugin() & preparePlugin() before the load gives up on it
 constexpr char PLUGINSOURCE[] = "plugin.h"; // source file path for plugin
+#ifndef BUILDDIR
+#define BUILDDIR "./build" // CMake passes its build folder, so the plugin is found from any working directory (e.g. ctest)
+#endif
+constexpr char IRFILE[] = "ir.wav"; // impulse response for plugin.h's convolve toggle, mono or stereo, in the resource folder (the repo root when live)
 constexpr short BYTETOBITS = 8;
 constexpr short RECORDBITDEPTH = 16;
-constexpr float INVSAMPLERATE = 1.f / SAMPLERATE;
 
 constexpr float PI = 3.14159265358979323846f;
 constexpr float TWOPI = PI + PI;
@@ -25,6 +39,14 @@ constexpr float PISQUARED = PI * PI;
 constexpr float INVPI = 1.f / PI;
 constexpr float INV60 = 1.f / 60;
 
+// a queued parameter change, applied by the audio thread at the start of a block
+struct ParamChange
+{
+    int param = 0; // index into PARAMNAMES
+    float value = 0.f;
+    int instance = 0; // plugin instance, 0 follows the UI
+};
+
 // -----------------------------------------------------------------------------
 // Globals
 // -----------------------------------------------------------------------------
@@ -32,26 +54,104 @@ struct Globals
 {
     std::atomic<int> writeHead = 0; // circular buffer write head
     std::atomic<bool> reloading = 0; // flag to prevent double reloads
-    std::vector<float> circularOutput = std::vector<float>(RECORDFRAMES + BUFFERFRAMES, 0.f); // circular buffer for output frames, sized with 1 extra buffer
-    std::vector<float> wavWriteFloats = std::vector<float>(RECORDFRAMES, 0.f);
+    std::atomic<int> sampleRate = SAMPLERATE; // sampleRate of the running stream
+    std::atomic<int> bufferFrames = BUFFERFRAMES; // frames per callback negotiated with RtAudio
+    std::atomic<float> latencyMs = 0.f; // output latency reported by RtAudio + 1 buffer
+    std::atomic<float> dspLoad = 0.f; // smoothed plugin process time as a fraction of the block period
+    std::atomic<bool> saveSession = 0; // set by the UI, the main thread writes the session file
+    std::atomic<bool> quitRequested = 0; // UI closed, SIGINT or SIGTERM, the main thread saves the session & exits
+    std::atomic<bool> reloadRequested = 0; // set by the remote control server, the main thread rebuilds & reloads the plugin
+    std::atomic<float> meterRms = 0.f; // mono output level of the last block
+    std::atomic<float> meterPeak = 0.f;
+    std::atomic<int> numInstances = 1; // plugin instances being mixed to the output
+    std::atomic<float> deadline = DEADLINEPERCENT / 100.f; // plugin time limit as a fraction of the block period, 0 = no watchdog
+    std::atomic<int> missLimit = MISSLIMIT; // deadline misses in a row before the plugin trips
+    std::atomic<int> deadlineMisses = 0; // blocks the plugin didn't finish in time, since startup
+    std::atomic<int> pluginTrips = 0; // times a plugin was switched off for missing deadlines, since startup
+    std::atomic<bool> pluginTripped = 0; // the current plugin is switched off until plugin.h is saved again
+    std::atomic<int> callbackCount = 0; // audio callbacks completed, lets the main thread wait 1 out
+    SpscQueue<ParamChange, 1024> paramQueue; // remote control server --> audio thread, batches land in the same block
+    int recordDuration = RECORDDURATION; // number of seconds to record
+    std::vector<float> circularOutput; // circular buffer for output frames
+    std::vector<float> wavWriteFloats;
+
+    // size buffers for the longest recording at the highest sampleRate, so the stream can be reopened at any rate without reallocating
+        // call before starting any threads that read the buffers
+    void allocate(int seconds)
+    {
+        recordDuration = seconds;
+        circularOutput.assign(seconds * MAXSAMPLERATE + MAXBUFFERFRAMES, 0.f); // sized with 1 extra buffer
+        wavWriteFloats.assign(seconds * MAXSAMPLERATE, 0.f);
+    }
+    int recordFrames() { return recordDuration * sampleRate.load(); } // number of frames to record at the current sampleRate
 };
 
 // hold function pointers and state for hot loaded data from plugin.cpp
 struct PluginModule 
 {
     void* handle = nullptr;                 // dynamic library handle returned by dlopen()
-    void* state = nullptr;                  // pointer to DSPState instance created by DSP module
-    void* (*create)(void*);                 // function pointer: createDSP()
+    void* state = nullptr;                  // pointer to DSPState instance created by DSP module (instance 0)
+    void* (*create)(void*, const void*);    // function pointer: createDSP() + uiParams + shared
     void (*destroy)(void*);                 // function pointer: destroyDSP()
+    void (*prepare)(void*, int, int, void*); // function pointer: preparePlugin() + sampleRate + maxBlock + RealtimeArena (may be null)
     void (*process)(void*, float*, int);    // function pointer: processAudio() + floatOut + numFrames
+    int (*saveState)(void*, void*, int) = nullptr;       // optional: state + buffer + capacity, returns bytes needed
+    void (*loadState)(void*, const void*, int) = nullptr; // optional: state + data + size
+    void (*idle)(void*) = nullptr;          // optional: state, main thread housekeeping every ~200 ms
+    void* shared = nullptr;                 // read-only tables built once per loaded module, shared by every instance
+    void* (*initModule)(const char*) = nullptr; // optional: resourceDir, builds shared
+    void (*deinitModule)(void*) = nullptr;  // optional: frees shared
+    int stateSize = 0;                      // optional: bytes per instance, for placing instances in 1 arena
+    void* (*createAt)(void*, void*, const void*) = nullptr; // optional: memory + uiParams + shared
+    void (*destroyAt)(void*) = nullptr;     // optional: destruct without freeing the memory
 };
 
+// parameter registry, lets scripts address UiParams by name. Keep in sync with UiParams::get() / set()
+constexpr const char* PARAMNAMES[] = { "freq", "gain", "phase", "bypass", "saturate", "convolve" };
+constexpr int NUMPARAMS = sizeof(PARAMNAMES) / sizeof(PARAMNAMES[0]);
+
 struct UiParams
 {
     std::atomic<float> freq = 220.f;
     std::atomic<float> gain = 0.5f;
     std::atomic<float> phase = 0.f;
     std::atomic<bool> bypass = 0;
+    std::atomic<bool> saturate = 0;
+    std::atomic<bool> convolve = 0;
+
+    std::atomic<bool> offline = 0; // set by the host for offline renders, plugins should then avoid timing dependent work (e.g. background threads)
+
+    // index into PARAMNAMES, -1 if unknown
+    static int find(const std::string& name)
+    {
+        for (int id = 0; id < NUMPARAMS; id++) if (name == PARAMNAMES[id]) return id;
+        return -1;
+    }
+    float get(int id) const
+    {
+        switch (id)
+        {
+            case 0: return freq.load();
+            case 1: return gain.load();
+            case 2: return phase.load();
+            case 3: return bypass.load();
+            case 4: return saturate.load();
+            case 5: return convolve.load();
+            default: return 0.f;
+        }
+    }
+    void set(int id, float value) // bools are on when value >= 0.5
+    {
+        switch (id)
+        {
+            case 0: freq.store(value); break;
+            case 1: gain.store(value); break;
+            case 2: phase.store(value); break;
+            case 3: bypass.store(value >= 0.5f); break;
+            case 4: saturate.store(value >= 0.5f); break;
+            case 5: convolve.store(value >= 0.5f); break;
+        }
+    }
 };
 
 // circular buffer for logging standard output
@@ -0,0 +1,191 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+// ----------------------------------------------------------------------------------------------
+// Golden output tests: render plugin.h offline from a script & compare with a stored .wav
+    // lets DSP rewrites (SIMD, approximations, ..) be accepted with a known accuracy cost
+//
+// Script format, one setting or parameter change per line, '#' starts a comment:
+    // frames 96000         number of frames to render
+    // rate 48000           sampleRate (default --rate)
+    // block 256            frames per processPlugin() call (default --block)
+    // golden sine.wav      golden file, relative to the script
+    // tolerance 0          max abs error allowed, 0 = bit exact (default)
+    // 0 freq 440           <frame> <param> <value>, any name from PARAMNAMES
+//
+// The plugin reads its data files (ir.wav) from the script's folder, never the working directory,
+    // so a render only depends on what's checked in next to the script. See tests/ & ctest
+// ----------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "golden.h"
+#include "render.h"
+#include "wavEncoder.h"
+
+struct GoldenScript
+{
+    int numFrames = 0;
+    int sampleRate = SAMPLERATE;
+    int blockSize = BUFFERFRAMES;
+    std::string goldenPath = "";
+    double tolerance = 0.0;
+    std::vector<ParamEvent> events;
+};
+
+static bool parseScript(const std::string& path, GoldenScript& script, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        error = "can't open " + path;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        std::istringstream words(line.substr(0, line.find('#')));
+        std::string first;
+        if (!(words >> first)) continue; // blank or comment
+
+        bool ok = true;
+        if (first == "frames") ok = static_cast<bool>(words >> script.numFrames) && script.numFrames > 0;
+        else if (first == "rate") ok = static_cast<bool>(words >> script.sampleRate) && script.sampleRate > 0;
+        else if (first == "block") ok = static_cast<bool>(words >> script.blockSize) && script.blockSize > 0 && script.blockSize <= static_cast<int>(MAXBUFFERFRAMES);
+        else if (first == "golden") ok = static_cast<bool>(words >> script.goldenPath);
+        else if (first == "tolerance") ok = static_cast<bool>(words >> script.tolerance) && script.tolerance >= 0.0;
+        else
+        {
+            ParamEvent event;
+            std::string name;
+            ok = static_cast<bool>(std::istringstream(first) >> event.frame) && static_cast<bool>(words >> name >> event.value);
+            event.param = UiParams::find(name);
+            if (ok && event.param < 0)
+            {
+                error = path + ":" + std::to_string(lineNumber) + ": unknown parameter '" + name + "'";
+                return false;
+            }
+            script.events.push_back(event);
+        }
+        if (!ok)
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": can't parse '" + line + "'";
+            return false;
+        }
+    }
+    if (script.numFrames == 0 || script.goldenPath.empty())
+    {
+        error = path + ": needs 'frames' and 'golden' lines";
+        return false;
+    }
+    // golden files live next to their script
+    script.goldenPath = (std::filesystem::path(path).parent_path() / script.goldenPath).string();
+    std::stable_sort(script.events.begin(), script.events.end(), [](const ParamEvent& a, const ParamEvent& b) { return a.frame < b.frame; });
+    return true;
+}
+
+// compare a render with its golden, prints one result line & returns true if within tolerance
+static bool compare(const std::string& name, const GoldenScript& script, const std::vector<float>& render, const std::vector<float>& golden)
+{
+    if (render.size() != golden.size())
+    {
+        std::printf("FAIL %s: rendered %zu frames, golden has %zu\n", name.c_str(), render.size() / 2, golden.size() / 2);
+        return false;
+    }
+
+    double maxError = 0.0;
+    double signalEnergy = 0.0;
+    double errorEnergy = 0.0;
+    long firstDifference = -1;  // any error at all
+    long firstFailure = -1;     // error over the tolerance
+    for (std::size_t i = 0; i < render.size(); i++)
+    {
+        double error = std::fabs(static_cast<double>(render[i]) - golden[i]);
+        if (firstDifference < 0 && error > 0.0) firstDifference = static_cast<long>(i);
+        if (firstFailure < 0 && error > script.tolerance) firstFailure = static_cast<long>(i);
+        if (error > maxError) maxError = error;
+        signalEnergy += static_cast<double>(golden[i]) * golden[i];
+        errorEnergy += error * error;
+    }
+
+    char snr[32] = "inf";
+    if (errorEnergy > 0.0) std::snprintf(snr, sizeof(snr), "%.1f", 10.0 * std::log10(signalEnergy / errorEnergy));
+    bool bitExact = errorEnergy == 0.0;
+    std::printf("%s %s: max abs error %.3g, SNR %s dB%s\n", firstFailure < 0 ? "PASS" : "FAIL", name.c_str(), maxError, snr, bitExact ? " (bit exact)" : "");
+    if (firstFailure >= 0)
+    {
+        std::printf("     first difference at frame %ld (%s): rendered %.9g, golden %.9g\n", firstDifference / 2, 
+                    firstDifference % 2 ? "right" : "left", render[firstDifference], golden[firstDifference]);
+        std::printf("     first over tolerance at frame %ld (%s): rendered %.9g, golden %.9g\n", firstFailure / 2, 
+                    firstFailure % 2 ? "right" : "left", render[firstFailure], golden[firstFailure]);
+    }
+    return firstFailure < 0;
+}
+
+int runGoldenTests(const HostConfig& config)
+{
+    std::string error;
+    int failures = 0;
+    for (const std::string& path : config.testScripts)
+    {
+        GoldenScript script;
+        script.sampleRate = config.sampleRate;
+        script.blockSize = config.bufferFrames;
+        if (!parseScript(path, script, error))
+        {
+            std::printf("FAIL %s\n", error.c_str());
+            failures++;
+            continue;
+        }
+
+        // a fresh module per script, its shared tables built from the script's folder
+        PluginModule module{};
+        std::string resourceDir = std::filesystem::path(path).parent_path().string();
+        if (!openPluginModule(module, error, 0, resourceDir.empty() ? "." : resourceDir))
+        {
+            std::printf("FAIL %s: %s\n", path.c_str(), error.c_str());
+            failures++;
+            continue;
+        }
+        UiParams params; // fresh defaults for every script
+        std::vector<float> render;
+        renderPlugin(module, params, script.events, script.sampleRate, script.blockSize, script.numFrames, render);
+        closePluginModule(module);
+
+        if (config.updateGolden)
+        {
+            bool written = writeWavFile(script.goldenPath, render, 2, script.sampleRate);
+            std::printf("%s %s -> %s\n", written ? "UPDATED" : "FAIL", path.c_str(), script.goldenPath.c_str());
+            if (!written) failures++;
+            continue;
+        }
+
+        std::vector<float> golden;
+        int numChannels = 0;
+        int sampleRate = 0;
+        if (!readWav(script.goldenPath, golden, numChannels, sampleRate) || numChannels != 2)
+        {
+            std::printf("FAIL %s: can't read stereo golden %s, create it with --update-golden\n", path.c_str(), script.goldenPath.c_str());
+            failures++;
+            continue;
+        }
+        if (sampleRate != script.sampleRate)
+        {
+            std::printf("FAIL %s: golden %s is %d Hz, the script renders at %d Hz\n", path.c_str(), script.goldenPath.c_str(), sampleRate, script.sampleRate);
+            failures++;
+            continue;
+        }
+        if (!compare(path, script, render, golden)) failures++;
+    }
+    std::printf("%d of %zu golden tests passed\n", static_cast<int>(config.testScripts.size()) - failures, config.testScripts.size());
+    return failures;
+}
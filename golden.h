@@ -0,0 +1,10 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include "config.h"
+
+// render each --test script & compare against its golden .wav (or rewrite it with --update-golden)
+    // returns the number of failed scripts, results are printed to stdout
+int runGoldenTests(const HostConfig& config);
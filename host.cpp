@@ -1,17 +1,30 @@
 // Copyright 2026 Reclaimed BCN. All rights reserved.
 // Use of this source code is governed by the license found in the LICENSE file.
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <memory>
 #include <thread>
 #include <filesystem>
 #include <chrono>
-#include <dlfcn.h>
+#include <csignal>
+#include <cstdlib>
 #include <string>
 
 #include "RtAudio.h"
 
 #include "globals.h"
+#include "config.h"
+#include "bench.h"
+#include "render.h"
+#include "watchdog.h"
+#include "rtCheck.h"
+#include "golden.h"
+#include "batch.h"
+#include "session.h"
+#include "remote.h"
 #include "wavEncoder.h"
 #include "ui.h"
 
@@ -19,70 +32,120 @@ static_assert (std::atomic<float>::is_always_lock_free); // check float type is
 
 // Globals
 Globals globals;
-unsigned int rtBufferFrames = BUFFERFRAMES; // assign constant to mutable as RtAudio will change value if unsupported by system
+HostConfig config; // runtime selectable device, sampleRate & block size
 LogBuffer logBuff; // circular buffer for logging standard output
-PluginModule plugin{}; // for filling with hot loaded PluginState pointers
+std::unique_ptr<PluginSlot> currentPlugin; // latest plugin.h build, its instances & worker thread
+std::unique_ptr<PluginSlot> fallbackPlugin; // previous good build, kept loaded to fall back to
+std::atomic<PluginSlot*> activePlugin = nullptr; // what the callback processes, swapped on reload
+std::atomic<bool> streamRunning = false; // callbacks may be running, only false whilst the stream is stopped
+DeadlineWatchdog watchdog; // audio thread only
+int loggedTrips = 0; // globals.pluginTrips already logged, main thread only
 UiParams uiParams;
+std::unique_ptr<UiParams[]> instanceParams; // instances 1..N-1, outlive every reload so their values carry over
 
-// Get platform-specific shared library filename
-std::string sharedLibraryName(const std::string& baseName)
+// -------------------------------------------------------------------------
+// Wait until the callback has certainly finished with any slot it read before this call
+    // false if a running stream's callback hasn't come back within timeout (e.g. a stuck plugin with --deadline 0)
+// -------------------------------------------------------------------------
+bool waitForCallback(std::chrono::milliseconds timeout)
 {
-#if defined(_WIN32) // Windows
-    return baseName + ".dll";
-#elif defined(__APPLE__) && defined(__MACH__) // macOS
-    return "lib" + baseName + ".dylib";
-#elif defined(__linux__) // Linux
-    return "lib" + baseName + ".so";
-#else
-    #error Unsupported platform
-#endif
+    int count = globals.callbackCount.load();
+    auto giveUp = std::chrono::steady_clock::now() + timeout;
+    while (globals.callbackCount.load() - count < 2)
+    {
+        if (!streamRunning.load()) return true; // stopped streams make no callbacks
+        if (std::chrono::steady_clock::now() > giveUp) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
 }
 
 // ----------------------------------------------------------------------------------------------
-// Load / Reload the Plugin shared library (.dylib/.so/.dll) and update the PluginModule struct
+// A new build's PluginSlot, made on a disposable thread so a plugin stuck in initModule(), createPlugin()
+// or preparePlugin() only takes that thread. Loader & builder race to move step on from BUILDING,
+// an abandoned build is freed by its builder if it ever finishes
 // ----------------------------------------------------------------------------------------------
-bool loadPlugin(PluginModule& plugin) 
+struct PendingBuild
 {
-    std::string pluginPath = "./build/plugins/" + sharedLibraryName("plugin");
-    // Try to open the shared library file
-    void* handle = dlopen(pluginPath.c_str(), RTLD_NOW);
-    if (!handle) // null ptr check
+    enum Step { BUILDING, BUILT, ABANDONED };
+    std::atomic<int> step = BUILDING;
+    std::unique_ptr<PluginSlot> slot;       // written by the builder before it moves step to BUILT
+    std::string error;                      // empty if slot is ready to play
+};
+
+void buildPluginSlot(std::shared_ptr<PendingBuild> build, int version)
+{
+    auto slot = std::make_unique<PluginSlot>();
+    std::string error;
+    if (openPluginModule(slot->module, error, version)
+        // Create & preallocate every instance for the running stream, then start the slot's worker thread
+        && slot->instances.create(slot->module, config.instances, static_cast<std::size_t>(config.arenaMb) << 20, uiParams, instanceParams.get(), error))
     {
-        std::cerr << "Failed to load Plugin: " << dlerror() << "\n";
-        return false;
+        slot->instances.prepare(globals.sampleRate.load(), globals.bufferFrames.load());
+        slot->module.state = slot->instances.state(0);
+        slot->startWorker();
     }
+    else if (error.empty()) error = "Plugin failed to load";
+    build->slot = std::move(slot);
+    build->error = error;
+    int expected = PendingBuild::BUILDING;
+    build->step.compare_exchange_strong(expected, PendingBuild::BUILT); // fails if the loader gave up, the slot is then freed with build
+}
 
-    // Resolve the symbols (function names) expected from plugin.cpp
-        // strings and types must match what's declared in plugin.h and implemented in plugin.cpp
-    auto createFn  = (void* (*)(void*))dlsym(handle, "createPlugin");
-    auto destroyFn = (void (*)(void*))dlsym(handle, "destroyPlugin");
-    auto processFn = (void (*)(void*, float*, int))dlsym(handle, "processPlugin");
+// ----------------------------------------------------------------------------------------------
+// Load / Reload the Plugin shared library (.dylib/.so/.dll) into a new PluginSlot
+    // the outgoing build is kept as the fallback if it was running fine, the one before is freed
+    // a build stuck loading for LOADTIMEOUT seconds is left behind with its thread (like retire()), the running build stays
+// ----------------------------------------------------------------------------------------------
+bool loadPlugin() 
+{
+    static int version = 0; // each build is loaded from its own copy so 2 can be loaded at once
+    auto build = std::make_shared<PendingBuild>();
+    std::thread(buildPluginSlot, build, ++version).detach(); // an ordinary thread, nothing to demote if it spins
 
-    // Check all functions were found
-    if (!createFn || !destroyFn || !processFn) 
+    auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(LOADTIMEOUT);
+    while (build->step.load() == PendingBuild::BUILDING && std::chrono::steady_clock::now() < giveUp)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    int expected = PendingBuild::BUILDING;
+    if (build->step.compare_exchange_strong(expected, PendingBuild::ABANDONED))
     {
-        std::cerr << "Invalid Plugin symbols: " << dlerror() << "\n";
-        dlclose(handle);
+        logBuff.setNewLine("PLUGIN STUCK: initModule(), createPlugin() or preparePlugin() hasn't returned after " + std::to_string(LOADTIMEOUT) 
+                           + " s, left loading in the background. Save plugin.h to try again");
         return false;
     }
-
-    // If plugin is already loaded, free it's memory before creating a new PluginState object
-    if (plugin.destroy && plugin.state) 
+    if (!build->error.empty())
     {
-        plugin.destroy(plugin.state);
+        std::cerr << build->error << "\n";
+        return false;
     }
-    // Create a new PluginState instance with the new module
-    void* newState = createFn(&uiParams);
+    std::unique_ptr<PluginSlot> slot = std::move(build->slot);
 
-    // Unload the previous shared library (if any) before replacing it
-    if (plugin.handle) dlclose(plugin.handle);
+    // a build that tripped the watchdog is no good to fall back to, keep the older one instead
+    std::unique_ptr<PluginSlot> retired;
+    if (currentPlugin && !currentPlugin->tripped.load())
+    {
+        retired = std::move(fallbackPlugin);
+        fallbackPlugin = std::move(currentPlugin);
+    }
+    else retired = std::move(currentPlugin);
+    slot->fallback = fallbackPlugin.get();
 
-    // Store the new handles and function pointers.
-    plugin.handle  = handle;
-    plugin.state   = newState;
-    plugin.create  = createFn;
-    plugin.destroy = destroyFn;
-    plugin.process = processFn;
+    // Swap it in, then free the retired build once the callback can't be using it
+        // a callback that never comes back may still be inside it, so it's leaked instead
+    currentPlugin = std::move(slot);
+    activePlugin.store(currentPlugin.get());
+    globals.pluginTripped.store(false);
+    if (retired)
+    {
+        if (waitForCallback(std::chrono::seconds(2))) PluginSlot::retire(std::move(retired));
+        else
+        {
+            retired.release();
+            logBuff.setNewLine("Audio callback stuck, the previous build stays loaded");
+        }
+    }
 
     logBuff.setNewLine("Plugin reloaded successfully");
     return true;
@@ -95,26 +158,192 @@ int callback(void* outBuffer, void*, unsigned int numFrames, double, RtAudioStre
 {
     if(userData) // null pointer check
     {
-        // cast userData pointer back to a PluginModule object pointer, same for globals
-        PluginModule* plugin = static_cast<PluginModule*>(userData);
+        // cast userData pointer back to the active PluginSlot pointer, same for globals
+        PluginSlot* slot = static_cast<std::atomic<PluginSlot*>*>(userData)->load();
+        float* out = static_cast<float*>(outBuffer);
+        AudioThreadScope audioThread; // RT_ALLOC_CHECK builds report any allocation from here on
+        auto start = std::chrono::steady_clock::now();
 
-        // If the plugin is loaded and valid, generate samples via processAudio function in plugin.cpp
-        if (plugin->process && plugin->state) plugin->process(plugin->state, static_cast<float*>(outBuffer), numFrames);
-        // Otherwise, output silence (avoid noise on error)
-        else std::fill_n(static_cast<float*>(outBuffer), numFrames, 0.0f);
+        // apply parameter changes queued by the remote control server, whole batches at a time
+        ParamChange change;
+        while (globals.paramQueue.pop(change))
+        {
+            if (slot && change.instance < slot->instances.size()) slot->instances.params(change.instance).set(change.param, change.value);
+        }
+
+        // Generate samples via processAudio function in plugin.cpp, mixing every instance
+            // the watchdog stops waiting at the deadline & plays the previous good build (or silence) instead
+        watchdog.process(slot, out, numFrames, start, globals);
 
-        // write ouput buffer to circular buffer for extra functions
+        // time spent in the plugin as a fraction of the block period, smoothed over ~20 blocks
+        std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+        float load = elapsed.count() * globals.sampleRate.load() / numFrames;
+        float dspLoad = globals.dspLoad.load();
+        globals.dspLoad.store(dspLoad + 0.05f * (load - dspLoad));
+
+        // write ouput buffer to circular buffer for extra functions, mixed down to mono
+        float sumSquares = 0.f;
+        float peak = 0.f;
         for (int i=0; i<numFrames; i++) 
         {
             int writeHead = globals.writeHead.load();
-            globals.circularOutput[writeHead] = static_cast<float*>(outBuffer)[i];
+            float mono = 0.5f * (out[2*i+0] + out[2*i+1]);
+            globals.circularOutput[writeHead] = mono;
             int wrapped = (writeHead + 1) % globals.circularOutput.size();
             globals.writeHead.store(wrapped);
+            sumSquares += mono * mono;
+            peak = std::max(peak, std::fabs(mono));
         }
+        globals.meterRms.store(std::sqrt(sumSquares / numFrames));
+        globals.meterPeak.store(peak);
+        globals.callbackCount.fetch_add(1);
     }
     return 0; // exit code so RtAudio continues streaming
 }
 
+// -------------------------------------------------------------------------
+// Re-prepare every loaded build for the stream's sampleRate & block size, the stream must be stopped
+// -------------------------------------------------------------------------
+void preparePlugins(int sampleRate, int maxBlock)
+{
+    for (PluginSlot* slot : { currentPlugin.get(), fallbackPlugin.get() })
+    {
+        if (!slot || slot->tripped.load()) continue; // never processed again
+        if (!slot->waitIdle(std::chrono::milliseconds(500)))
+        {
+            // stuck in a late block, don't touch its state. Switched off like the watchdog does, but logged here
+            slot->tripped.store(true);
+            slot->demoteWorker();
+            if (slot == currentPlugin.get()) globals.pluginTripped.store(true);
+            globals.pluginTrips.fetch_add(1);
+            loggedTrips++; // any trip of the watchdog's not logged yet still is
+            logBuff.setNewLine(std::string("PLUGIN STUCK: ") + (slot == currentPlugin.get() ? "the current" : "the previous") 
+                               + " build is still in a late block after 500 ms, switched off. Save plugin.h to try again");
+            continue;
+        }
+        slot->instances.prepare(sampleRate, maxBlock);
+    }
+}
+
+// -------------------------------------------------------------------------
+// Log a readable description of an RtAudio error code
+// -------------------------------------------------------------------------
+void logRtAudioError(RtAudio& dac, RtAudioErrorType errCode)
+{
+    logBuff.setNewLine(dac.getErrorText());
+    if (errCode == 0) logBuff.setNewLine("No error");
+    else if (errCode == 1) logBuff.setNewLine("Non-critical error");
+    else if (errCode == 2) logBuff.setNewLine("Unspecified error type");
+    else if (errCode == 3) logBuff.setNewLine("No devices found");
+    else if (errCode == 4) logBuff.setNewLine("Invalid device ID was specified");
+    else if (errCode == 5) logBuff.setNewLine("Device in use was disconnected");
+    else if (errCode == 6) logBuff.setNewLine("Error occurred during memeory allocation");
+    else if (errCode == 7) logBuff.setNewLine("Invalid parameter was specified to a fucntion");
+    else if (errCode == 8) logBuff.setNewLine("Function was called incoorectly");
+    else if (errCode == 9) logBuff.setNewLine("System driver error occurred");
+    else if (errCode == 10) logBuff.setNewLine("System error occurred");
+    else if (errCode == 11) logBuff.setNewLine("Thread error ocurred");
+}
+
+// -------------------------------------------------------------------------
+// Find an output device by id or by (part of) its name, 0 if not found
+// -------------------------------------------------------------------------
+unsigned int findOutputDevice(RtAudio& dac, const std::string& device)
+{
+    if (device.empty()) return dac.getDefaultOutputDevice();
+    for (unsigned int id : dac.getDeviceIds())
+    {
+        RtAudio::DeviceInfo info = dac.getDeviceInfo(id);
+        if (info.outputChannels < 2) continue;
+        if (std::to_string(id) == device || info.name.find(device) != std::string::npos) return id;
+    }
+    return 0; // RtAudio never hands out id 0
+}
+
+void listOutputDevices(RtAudio& dac)
+{
+    unsigned int defaultId = dac.getDefaultOutputDevice();
+    for (unsigned int id : dac.getDeviceIds())
+    {
+        RtAudio::DeviceInfo info = dac.getDeviceInfo(id);
+        if (info.outputChannels < 2) continue;
+        std::cout << id << ": " << info.name << (id == defaultId ? " (default)" : "") << "\n    rates:";
+        for (unsigned int rate : info.sampleRates) std::cout << " " << rate;
+        std::cout << "\n";
+    }
+}
+
+// -------------------------------------------------------------------------
+// (Re)open the output stream with the current config & re-prepare the plugin
+    // the stream must be stopped, so the plugin is never prepared whilst processing
+// -------------------------------------------------------------------------
+bool openAudioStream(RtAudio& dac)
+{
+    if (dac.isStreamRunning()) dac.stopStream();
+    streamRunning.store(false);
+    if (dac.isStreamOpen()) dac.closeStream();
+
+    // Configure output stream parameters
+    RtAudio::StreamParameters streamParams;
+    streamParams.deviceId = findOutputDevice(dac, config.device);
+    streamParams.nChannels = 2; // stereo output
+    if (!streamParams.deviceId)
+    {
+        logBuff.setNewLine("No output device matching '" + config.device + "'");
+        return false;
+    }
+
+    // assign to mutable as RtAudio will change value if unsupported by system
+    unsigned int rtBufferFrames = config.bufferFrames;
+    RtAudioErrorType errCode = RTAUDIO_NO_ERROR;
+    try
+    {
+        errCode = dac.openStream(&streamParams,     // output stream parameters
+                                 nullptr,           // no input stream
+                                 RTAUDIO_FLOAT32,   // sample format
+                                 config.sampleRate,
+                                 &rtBufferFrames,   // number of sample frames per callback
+                                 callback,          // callback function name
+                                 &activePlugin);    // userData to pass to callback
+    }
+    catch (RtAudioErrorType& err) { errCode = err; }
+    if (errCode != RTAUDIO_NO_ERROR)
+    {
+        logRtAudioError(dac, errCode);
+        return false;
+    }
+
+    // store what RtAudio actually negotiated, then preallocate the plugin for it
+    globals.sampleRate.store(dac.getStreamSampleRate());
+    globals.bufferFrames.store(rtBufferFrames);
+    if (rtBufferFrames > MAXBUFFERFRAMES)
+    {
+        logBuff.setNewLine("Device block size " + std::to_string(rtBufferFrames) + " is larger than supported");
+        dac.closeStream();
+        return false;
+    }
+    preparePlugins(globals.sampleRate.load(), rtBufferFrames);
+    globals.dspLoad.store(0.f);
+
+    streamRunning.store(true); // before the first callback can read activePlugin
+    errCode = dac.startStream();
+    if (errCode != RTAUDIO_NO_ERROR)
+    {
+        streamRunning.store(false);
+        logRtAudioError(dac, errCode);
+        return false;
+    }
+
+    // report latency so block sizes can be compared
+    float latencyFrames = dac.getStreamLatency() + rtBufferFrames;
+    globals.latencyMs.store(1000.f * latencyFrames / globals.sampleRate.load());
+    logBuff.setNewLine("Audio stream running: " + dac.getDeviceInfo(streamParams.deviceId).name + ", " 
+                       + std::to_string(globals.sampleRate.load()) + " Hz, " + std::to_string(rtBufferFrames) + " frames, " 
+                       + std::to_string(globals.latencyMs.load()) + " ms latency"
+                       + (currentPlugin->instances.size() > 1 ? ", " + std::to_string(currentPlugin->instances.size()) + " instances" : ""));
+    return true;
+}
+
 // -------------------------------------------------------------------------
 // Async function for exporting a .wav file
 // -------------------------------------------------------------------------
@@ -125,28 +354,82 @@ void wavWriteThread() { writeWav(globals, logBuff); }
 // -------------------------------------------------------------------------
 void uiThread() { drawUi(logBuff, globals, uiParams); }
 
+// -------------------------------------------------------------------------
+// Async function for the remote control server, see remote.cpp for the protocol
+// -------------------------------------------------------------------------
+void remoteThread() { runRemoteServer(config.remotePath, logBuff, globals, uiParams); }
+
+// -------------------------------------------------------------------------
+// SIGINT / SIGTERM handler, the main loop saves the session before exiting
+    // a second signal whilst it's saving exits straight away
+// -------------------------------------------------------------------------
+void requestQuit(int)
+{
+    if (globals.quitRequested.exchange(true)) std::_Exit(1);
+}
+
+// -------------------------------------------------------------------------
+// Headless runs, echo log lines written since readHead to standard output
+// -------------------------------------------------------------------------
+void echoLog(int& readHead)
+{
+    for (; readHead != logBuff.getWriteHead(); readHead = (readHead + 1) % logBuff.getSize())
+    {
+        std::cout << logBuff.getLine(readHead) << std::endl;
+    }
+}
+
 // -------------------------------------------------------------------------
 // Async function for reloading plugin code when plugin.h file is changed
 // -------------------------------------------------------------------------
 void reloadPluginThread()
 {
     // rebuild dynamic library
-    system("make -C build plugin");
-    loadPlugin(plugin); // reload plugin
+    system("make -C \"" BUILDDIR "\" plugin");
+    loadPlugin(); // reload plugin, the running build keeps playing if this fails
     globals.reloading.store(0); // re-enable hot-reloading
 }
 
 // -----------------------------------------------------------------------------
 // Entry point
 // -----------------------------------------------------------------------------
-int main() 
+int main(int argc, char** argv) 
 {
-    // Initial load, fill PluginModule's placeholders with data from plugin.cpp
-    if (!loadPlugin(plugin)) 
+    // Runtime settings, command line flags override the config file
+    std::string configError;
+    if (!parseArgs(argc, argv, config, configError))
     {
-        std::cerr << "Failed initial plugin load\n";
+        if (!configError.empty()) std::cerr << configError << "\n";
+        printUsage(argv[0]);
         return 1;
     }
+    if (config.bench)
+    {
+        runBenchmarks(config);
+        return 0;
+    }
+    if (!config.testScripts.empty()) return runGoldenTests(config) > 0;
+    if (!config.batchPath.empty()) return runBatch(config) ? 0 : 1;
+
+    // Restore the last session before anything makes a sound, flags & config file settings win over it
+    Session session;
+    std::string sessionError;
+    bool restored = loadSession(config.sessionPath, session, sessionError);
+    if (!sessionError.empty()) std::cerr << sessionError << "\n";
+    if (restored)
+    {
+        applySessionParams(session, 0, uiParams);
+        if (session.hasStream) // key by key, so e.g. --block alone keeps the session's device & rate
+        {
+            if (!config.explicitDevice) config.device = session.stream.device;
+            if (!config.explicitSampleRate) config.sampleRate = session.stream.sampleRate;
+            if (!config.explicitBufferFrames) config.bufferFrames = session.stream.bufferFrames;
+            if (!config.explicitRecordDuration) config.recordDuration = session.stream.recordDuration;
+        }
+    }
+    globals.allocate(config.recordDuration);
+    globals.sampleRate.store(config.sampleRate);
+    globals.bufferFrames.store(config.bufferFrames);
 
     // Setup RtAudio output stream
     RtAudio dac;
@@ -155,54 +438,70 @@ int main()
         std::cerr << "No audio devices found!\n";
         return 1;
     }
+    if (config.listDevices)
+    {
+        listOutputDevices(dac);
+        return 0;
+    }
 
-    // Configure output stream parameters
-    RtAudio::StreamParameters streamParams;
-    streamParams.deviceId = dac.getDefaultOutputDevice(); // default output
-    streamParams.nChannels = 2;                           // stereo output
+    // Initial load, fill PluginModule's placeholders with data from plugin.cpp
+    installAllocationCheck(logBuff);
+    globals.numInstances.store(config.instances);
+    globals.deadline.store(config.deadlinePercent / 100.f);
+    globals.missLimit.store(config.missLimit);
+    instanceParams = std::make_unique<UiParams[]>(config.instances - 1);
+    for (int i = 1; i < config.instances; i++)
+    {
+        for (int id = 0; id < NUMPARAMS; id++) instanceParams[i - 1].set(id, uiParams.get(id)); // start from the UI's sound
+        if (restored) applySessionParams(session, i, instanceParams[i - 1]);
+    }
+    if (!loadPlugin()) 
+    {
+        int logHead = 0;
+        echoLog(logHead); // e.g. a stuck plugin, there's no UI yet to show it
+        std::cerr << "Failed initial plugin load\n";
+        return 1;
+    }
+    PluginModule& plugin = currentPlugin->module;
+    for (int i = 0; restored && i < currentPlugin->instances.size() && i < static_cast<int>(session.pluginStates.size()); i++)
+    {
+        const std::vector<unsigned char>& state = session.pluginStates[i];
+        if (plugin.loadState && !state.empty()) plugin.loadState(currentPlugin->instances.state(i), state.data(), static_cast<int>(state.size()));
+    }
 
-    // start UI (and potentially wavWriter) in background
-    std::thread ui(uiThread);
-    ui.detach(); // run independently
+    // exit cleanly on Ctrl+C & kill, the UI's Close button does the same
+    std::signal(SIGINT, requestQuit);
+    std::signal(SIGTERM, requestQuit);
 
-    // Open and start the audio stream
-    try
+    // start UI (and potentially wavWriter) in background, headless runs are driven by the remote control server instead
+    if (!config.headless)
     {
-        dac.openStream(&streamParams,       // output stream parameters
-                       nullptr,             // no input stream
-                       RTAUDIO_FLOAT32,     // sample format
-                       SAMPLERATE,
-                       &rtBufferFrames,     // number of sample frames per callback
-                       callback,            // callback function name
-                       &plugin);            // userData to pass to callback
-        dac.startStream();
-    }
-    catch (RtAudioErrorType& errCode)
-    {
-        logBuff.setNewLine(dac.getErrorText());
-        if (errCode == 0) logBuff.setNewLine("No error");
-        else if (errCode == 1) logBuff.setNewLine("Non-critical error");
-        else if (errCode == 2) logBuff.setNewLine("Unspecified error type");
-        else if (errCode == 3) logBuff.setNewLine("No devices found");
-        else if (errCode == 4) logBuff.setNewLine("Invalid device ID was specified");
-        else if (errCode == 5) logBuff.setNewLine("Device in use was disconnected");
-        else if (errCode == 6) logBuff.setNewLine("Error occurred during memeory allocation");
-        else if (errCode == 7) logBuff.setNewLine("Invalid parameter was specified to a fucntion");
-        else if (errCode == 8) logBuff.setNewLine("Function was called incoorectly");
-        else if (errCode == 9) logBuff.setNewLine("System driver error occurred");
-        else if (errCode == 10) logBuff.setNewLine("System error occurred");
-        else if (errCode == 11) logBuff.setNewLine("Thread error ocurred");
-        return 1;
+        std::thread ui(uiThread);
+        ui.detach(); // run independently
+    }
+    if (!config.remotePath.empty())
+    {
+        std::thread remote(remoteThread);
+        remote.detach();
     }
-    logBuff.setNewLine("Audio stream running");
+
+    // Open and start the audio stream
+    if (!openAudioStream(dac)) return 1;
+    if (restored) logBuff.setNewLine("Session restored from " + config.sessionPath);
     logBuff.setNewLine("Edit plugin.h to hear changes live");
 
     // if plugin changes, reload in place without restarting program
     int firstTime = 0;
     std::filesystem::file_time_type lastWriteTime;
+    std::filesystem::file_time_type lastConfigWriteTime;
+    if (!config.configPath.empty()) lastConfigWriteTime = std::filesystem::last_write_time(config.configPath);
+    int logReadHead = 0; // headless: next log line to echo
+    int arenaFallbacks = 0;
+    int sessionWait = -1; // loops left to wait for the plugin's state snapshot, -1 = no save pending
+    int quitWait = -1; // loops left to wait for the session save before exiting, -1 = keep running
 
-    // Periodically check plugin.h file for changes
-    while (true) 
+    // Periodically check plugin.h file for changes, until asked to quit
+    while (quitWait != 0) 
     {
         auto currentTime = std::filesystem::last_write_time(PLUGINSOURCE);
         
@@ -213,19 +512,149 @@ int main()
             firstTime = 1;
         }
 
-        // start a new thread when file edited & not currently reloading
-        if ((currentTime != lastWriteTime) && !globals.reloading.load())
+        // start a new thread when file edited (or a remote /reload) & not currently reloading
+        if ((currentTime != lastWriteTime || globals.reloadRequested.load()) && !globals.reloading.load())
         {
             // prevent double reloads
             globals.reloading.store(1);
+            globals.reloadRequested.store(0);
             lastWriteTime = currentTime;
 
             logBuff.setNewLine("RELOADING PLUGIN");
             std::thread reload(reloadPluginThread);
             reload.detach(); // don't block main thread whilst reloading
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        // reopen the stream when the config file's device, sampleRate or block size changes
+        std::error_code fileError;
+        auto configTime = config.configPath.empty() ? lastConfigWriteTime : std::filesystem::last_write_time(config.configPath, fileError);
+        if (!fileError && configTime != lastConfigWriteTime && !globals.reloading.load())
+        {
+            lastConfigWriteTime = configTime;
+            HostConfig newConfig = config;
+            if (!loadConfigFile(config.configPath, newConfig, configError)) logBuff.setNewLine(configError);
+            else
+            {
+                // sized at startup, keep running with the current values
+                std::string restartKeys;
+                if (newConfig.instances != config.instances) restartKeys += " instances";
+                if (newConfig.arenaMb != config.arenaMb) restartKeys += " arena";
+                if (newConfig.recordDuration != config.recordDuration) restartKeys += " record";
+                if (newConfig.sessionPath != config.sessionPath) restartKeys += " session";
+                if (newConfig.remotePath != config.remotePath) restartKeys += " remote";
+                if (!restartKeys.empty()) logBuff.setNewLine("Config file changed" + restartKeys + ", restart required to apply");
+                newConfig.instances = config.instances;
+                newConfig.arenaMb = config.arenaMb;
+                newConfig.recordDuration = config.recordDuration;
+                newConfig.sessionPath = config.sessionPath;
+                newConfig.remotePath = config.remotePath;
+
+                // watchdog settings apply straight away, no need to touch the stream
+                if (newConfig.deadlinePercent != config.deadlinePercent || newConfig.missLimit != config.missLimit)
+                {
+                    config.deadlinePercent = newConfig.deadlinePercent;
+                    config.missLimit = newConfig.missLimit;
+                    globals.deadline.store(config.deadlinePercent / 100.f);
+                    globals.missLimit.store(config.missLimit);
+                    logBuff.setNewLine("Deadline " + std::to_string(config.deadlinePercent) + "% of the block period, " + std::to_string(config.missLimit) + " misses");
+                }
+                if (newConfig.device != config.device || newConfig.sampleRate != config.sampleRate || newConfig.bufferFrames != config.bufferFrames)
+                {
+                    HostConfig oldConfig = config;
+                    config = newConfig;
+                    logBuff.setNewLine("RESTARTING AUDIO STREAM");
+                    globals.reloading.store(1); // hold off plugin reloads whilst the plugin is re-prepared
+                    if (!openAudioStream(dac))
+                    {
+                        // the old stream is already closed, go back to the settings that worked
+                        logBuff.setNewLine("Can't open the new stream settings, back to the previous ones");
+                        config = oldConfig;
+                        if (!openAudioStream(dac)) logBuff.setNewLine("Can't reopen the previous stream either, fix the config file to retry");
+                    }
+                    globals.reloading.store(0);
+                }
+            }
+        }
+
+        // save the session before exiting, unless a reload keeps the builds busy for longer than ~5 s
+        if (globals.quitRequested.load() && quitWait < 0)
+        {
+            logBuff.setNewLine("Exiting, saving the session");
+            globals.saveSession.store(1);
+            quitWait = 25;
+        }
+        else if (quitWait > 0 && --quitWait == 0) logBuff.setNewLine("Reload still running, exiting without saving the session");
+
+        // the loaded builds are only looked at between reloads
+        if (!globals.reloading.load())
+        {
+            // write the session snapshot when the UI asks for it
+                // the plugin's state is copied by the thread processing it, picked up here on a later loop
+            if (globals.saveSession.exchange(0))
+            {
+                currentPlugin->instances.requestSnapshot();
+                sessionWait = 10; // ~2 s
+            }
+            if (sessionWait >= 0)
+            {
+                std::vector<std::vector<unsigned char>> pluginStates;
+                bool captured = currentPlugin->instances.takeSnapshot(pluginStates);
+                if (captured || sessionWait-- == 0)
+                {
+                    if (!captured) logBuff.setNewLine("Plugin isn't being processed, saving the session without its state");
+                    std::vector<const UiParams*> params = { &uiParams };
+                    for (int i = 1; i < config.instances; i++) params.push_back(&instanceParams[i - 1]);
+                    if (saveSession(config.sessionPath, captureSession(params, config, pluginStates), sessionError)) logBuff.setNewLine("Session saved to " + config.sessionPath);
+                    else logBuff.setNewLine(sessionError);
+                    sessionWait = -1;
+                    if (quitWait > 0) quitWait = 0; // saved, or saving failed & won't work on a retry either
+                }
+            }
+
+            // realtime memory problems, found by the audio thread & logged here
+            if (currentPlugin->instances.arenaFallbacks() != arenaFallbacks) // resets when the plugin reloads
+            {
+                arenaFallbacks = currentPlugin->instances.arenaFallbacks();
+                if (arenaFallbacks) logBuff.setNewLine("Plugin arena full, " + std::to_string(arenaFallbacks) + " heap allocations so far. Raise --arena");
+            }
+
+            // plugin housekeeping off the audio thread, e.g. starting convolver threads once convolve is switched on
+            for (PluginSlot* slot : { currentPlugin.get(), fallbackPlugin.get() })
+            {
+                if (slot && !slot->tripped.load()) slot->instances.idle();
+            }
+
+            // the watchdog switched the plugin off
+            if (globals.pluginTrips.load() != loggedTrips)
+            {
+                loggedTrips = globals.pluginTrips.load();
+                logBuff.setNewLine("PLUGIN OVERLOADED: " + std::to_string(globals.missLimit.load()) + " blocks in a row over " 
+                                   + std::to_string(config.deadlinePercent) + "% of the block period, "
+                                   + (fallbackPlugin && !fallbackPlugin->tripped.load() ? "switched back to the previous build" : "muted") + ". Save plugin.h to try again");
+            }
+        }
+        logAudioThreadAllocations(logBuff);
+
+        // without the terminal UI, echo new log lines to standard output
+        if (config.headless) echoLog(logReadHead);
+        if (quitWait != 0) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    // stop the callbacks, then free the builds unless a reload still owns them (a stuck build is leaked by retire())
+    if (dac.isStreamRunning()) dac.stopStream();
+    streamRunning.store(false);
+    if (dac.isStreamOpen()) dac.closeStream();
+    activePlugin.store(nullptr);
+    if (!globals.reloading.load())
+    {
+        PluginSlot::retire(std::move(currentPlugin));
+        PluginSlot::retire(std::move(fallbackPlugin));
+    }
+    else
+    {
+        currentPlugin.release();
+        fallbackPlugin.release();
     }
-    // Safety clean up (usually unreachable)
-    dac.closeStream();
+    if (config.headless) echoLog(logReadHead);
+    return 0;
 }
@@ -0,0 +1,133 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <algorithm>
+#include <new>
+
+#include "instances.h"
+
+bool PluginInstances::create(PluginModule& module, int count, std::size_t arenaBytes, UiParams& firstParams, UiParams* otherParams, std::string& error)
+{
+    destroy();
+    if (count < 1 || count > MAXINSTANCES)
+    {
+        error = "instances must be between 1 and " + std::to_string(MAXINSTANCES);
+        return false;
+    }
+    _module = &module;
+    _firstParams = &firstParams;
+    _otherParams = otherParams;
+    _scratch.assign(MAXBUFFERFRAMES * 2, 0.f);
+    _snapshots.assign(count, std::vector<unsigned char>(SNAPSHOTBYTES, 0));
+    _snapshotSizes.assign(count, 0);
+    _snapshotStep.store(SNAPSHOTIDLE);
+    _arenas = std::make_unique<RealtimeArena[]>(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (!_arenas[i].reserve(arenaBytes))
+        {
+            error = "can't reserve a " + std::to_string(arenaBytes >> 20) + " MB arena for instance " + std::to_string(i);
+            destroy();
+            return false;
+        }
+    }
+
+    // 1 allocation for every instance, each rounded up to whole cache lines
+    if (module.createAt && module.destroyAt && module.stateSize > 0)
+    {
+        _stride = (module.stateSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        _stateMemory = ::operator new(_stride * count, std::align_val_t(ALIGNMENT));
+        for (int i = 0; i < count; i++)
+        {
+            void* memory = static_cast<char*>(_stateMemory) + i * _stride;
+            _states.push_back(module.createAt(memory, &params(i), module.shared));
+        }
+    }
+    else // older plugins, 1 heap allocation each
+    {
+        for (int i = 0; i < count; i++) _states.push_back(module.create(&params(i), module.shared));
+    }
+    return true;
+}
+
+void PluginInstances::destroy()
+{
+    for (void* state : _states)
+    {
+        if (_stateMemory) _module->destroyAt(state);
+        else _module->destroy(state);
+    }
+    _states.clear();
+    if (_stateMemory) ::operator delete(_stateMemory, std::align_val_t(ALIGNMENT));
+    _stateMemory = nullptr;
+    _otherParams = nullptr;
+    _arenas.reset();
+}
+
+void PluginInstances::prepare(int sampleRate, int maxBlock)
+{
+    for (int i = 0; i < size(); i++) _module->prepare(_states[i], sampleRate, maxBlock, &_arenas[i]);
+}
+
+void PluginInstances::idle()
+{
+    if (!_module || !_module->idle) return;
+    for (void* state : _states) _module->idle(state);
+}
+
+void PluginInstances::requestSnapshot()
+{
+    if (_module && _module->saveState) _snapshotStep.store(SNAPSHOTREQUESTED, std::memory_order_release);
+}
+
+bool PluginInstances::takeSnapshot(std::vector<std::vector<unsigned char>>& states)
+{
+    states.clear();
+    if (_states.empty() || !_module->saveState) return true; // nothing to save
+    if (_snapshotStep.load(std::memory_order_acquire) != SNAPSHOTDONE) return false;
+    bool grown = false;
+    for (int i = 0; i < size(); i++)
+    {
+        if (_snapshotSizes[i] <= static_cast<int>(_snapshots[i].size())) continue;
+        _snapshots[i].resize(_snapshotSizes[i]); // larger than expected, grow & ask again
+        grown = true;
+    }
+    if (grown)
+    {
+        _snapshotStep.store(SNAPSHOTREQUESTED, std::memory_order_release);
+        return false;
+    }
+    states.resize(size());
+    for (int i = 0; i < size(); i++) states[i].assign(_snapshots[i].begin(), _snapshots[i].begin() + std::max(_snapshotSizes[i], 0));
+    _snapshotStep.store(SNAPSHOTIDLE);
+    return true;
+}
+
+void PluginInstances::process(float* out, int numFrames)
+{
+    if (_states.empty())
+    {
+        std::fill_n(out, numFrames * 2, 0.f);
+        return;
+    }
+
+    // between blocks, the only moment no instance's state is being written
+    if (_snapshotStep.load(std::memory_order_acquire) == SNAPSHOTREQUESTED)
+    {
+        for (int i = 0; i < size(); i++)
+        {
+            _snapshotSizes[i] = _module->saveState(_states[i], _snapshots[i].data(), static_cast<int>(_snapshots[i].size()));
+        }
+        _snapshotStep.store(SNAPSHOTDONE, std::memory_order_release);
+    }
+    _module->process(_states[0], out, numFrames); // instance 0 straight into the output
+    if (_states.size() == 1) return;
+
+    for (std::size_t i = 1; i < _states.size(); i++)
+    {
+        _module->process(_states[i], _scratch.data(), numFrames);
+        for (int n = 0; n < numFrames * 2; n++) out[n] += _scratch[n];
+    }
+    const float gain = 1.f / _states.size();
+    for (int n = 0; n < numFrames * 2; n++) out[n] *= gain;
+}
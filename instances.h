@@ -0,0 +1,75 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "globals.h"
+#include "rtAllocator.h"
+
+// ----------------------------------------------------------------------------------------------
+// N instances of 1 loaded plugin module, e.g. 1 per channel strip or test track
+    // instance states sit back to back in 1 contiguous arena (when the plugin exports createPluginAt)
+    // & all of them read the module's shared tables, built once by initModule()
+    // instance 0 follows the UI's UiParams, the others have their own, owned by the host so they outlive reloads
+    // each instance also gets its own pre-faulted RealtimeArena, passed to preparePlugin()
+// ----------------------------------------------------------------------------------------------
+class PluginInstances
+{
+    public:
+        static constexpr std::size_t ALIGNMENT = 64; // cache line, instances never share one
+        static constexpr std::size_t SNAPSHOTBYTES = 4096; // preallocated per instance for its saved state, grown if the plugin needs more
+
+        ~PluginInstances() { destroy(); }
+
+        // module must stay alive (& keep its function pointers) until destroy()
+            // otherParams holds count - 1 UiParams for instances 1..N-1, both outlive the instances
+        bool create(PluginModule& module, int count, std::size_t arenaBytes, UiParams& firstParams, UiParams* otherParams, std::string& error);
+        void destroy();
+
+        // never during process(), same rules as preparePlugin()
+        void prepare(int sampleRate, int maxBlock);
+
+        // main thread housekeeping for every instance (idlePlugin), alongside process()
+        void idle();
+
+        // render every instance & mix them to out (interleaved stereo), averaged so levels match 1 instance
+        void process(float* out, int numFrames);
+
+        // session snapshots of every instance (saveStatePlugin), taken by whichever thread runs process(), between 2 blocks
+            // so the main thread never reads state the plugin is writing
+            // main thread: requestSnapshot(), then call takeSnapshot() until it returns true (states stays empty without saveStatePlugin)
+        void requestSnapshot();
+        bool takeSnapshot(std::vector<std::vector<unsigned char>>& states);
+
+        int size() const { return static_cast<int>(_states.size()); }
+        void* state(int index) const { return _states[index]; }
+        UiParams& params(int index) { return index == 0 ? *_firstParams : _otherParams[index - 1]; }
+
+        // heap allocations across every instance because an arena was full, raise --arena if non zero
+        int arenaFallbacks() const
+        {
+            int fallbacks = 0;
+            for (int i = 0; i < size(); i++) fallbacks += _arenas[i].fallbacks();
+            return fallbacks;
+        }
+
+    private:
+        enum SnapshotStep { SNAPSHOTIDLE, SNAPSHOTREQUESTED, SNAPSHOTDONE };
+
+        PluginModule* _module = nullptr;
+        void* _stateMemory = nullptr;           // count * _stride bytes, null when the plugin can't be placed
+        std::size_t _stride = 0;
+        std::vector<void*> _states;
+        UiParams* _firstParams = nullptr;
+        UiParams* _otherParams = nullptr;       // instances 1..N-1, not owned
+        std::unique_ptr<RealtimeArena[]> _arenas; // [instance], outlive the states allocating from them
+        std::vector<float> _scratch;            // 1 instance's output whilst mixing
+        std::vector<std::vector<unsigned char>> _snapshots; // [instance], only resized by the main thread whilst no snapshot is requested
+        std::vector<int> _snapshotSizes;        // [instance], bytes saveStatePlugin() asked for, may be more than _snapshots holds
+        std::atomic<int> _snapshotStep = SNAPSHOTIDLE;
+};
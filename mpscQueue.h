@@ -0,0 +1,68 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------------------------
+// Lock-free multiple producer / single consumer ring buffer, realtime safe on the producer side
+    // each cell carries a sequence number, so a producer claims a cell with 1 compare & swap
+    // & the consumer only takes it once that producer has finished writing it
+// ----------------------------------------------------------------------------------------------
+template <typename T, std::uint32_t Capacity>
+class MpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    public:
+        MpscQueue()
+        {
+            for (std::uint32_t i = 0; i < Capacity; i++) _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // any thread, false if the queue is full
+        bool push(const T& item)
+        {
+            std::uint32_t write = _write.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = _cells[write & (Capacity - 1)];
+                const std::uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const std::int32_t difference = static_cast<std::int32_t>(sequence - write);
+                if (difference < 0) return false; // still holds an item from the previous lap
+                if (difference > 0) write = _write.load(std::memory_order_relaxed); // another producer took it
+                else if (_write.compare_exchange_weak(write, write + 1, std::memory_order_relaxed))
+                {
+                    cell.item = item;
+                    cell.sequence.store(write + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        // consumer thread only
+        bool pop(T& item)
+        {
+            const std::uint32_t read = _read.load(std::memory_order_relaxed);
+            Cell& cell = _cells[read & (Capacity - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) != read + 1) return false; // empty, or still being written
+            item = cell.item;
+            cell.sequence.store(read + Capacity, std::memory_order_release); // free for the producers' next lap
+            _read.store(read + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::uint32_t> sequence;
+            T item{};
+        };
+
+        std::array<Cell, Capacity> _cells;
+        alignas(64) std::atomic<std::uint32_t> _write = 0; // separate cache lines, so producers & consumer don't false share
+        alignas(64) std::atomic<std::uint32_t> _read = 0;
+};
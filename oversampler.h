@@ -0,0 +1,219 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "globals.h"
+
+// ----------------------------------------------------------------------------------------------
+// One 2x stage of a polyphase half-band FIR, linear phase
+    // every other coefficient of a half-band filter is zero (apart from the 0.5 centre tap)
+    // so only the odd branch is convolved, the other branch is a pure delay
+// ----------------------------------------------------------------------------------------------
+class HalfBandStage
+{
+    public:
+        // numTaps = number of non-zero odd branch coefficients (even, >= 2), the full filter has 2*numTaps-1 taps
+        void design(int numTaps, float kaiserBeta = 8.f)
+        {
+            _numTaps = numTaps;
+            _centre = numTaps - 1; // odd branch history length
+            _coeffs.assign(numTaps, 0.f);
+
+            // windowed sinc: h[k] = sin(pi*k/2) / (pi*k) for odd k in [-(numTaps-1), numTaps-1]
+            const int halfLength = numTaps - 1;
+            float sum = 0.f;
+            for (int i = 0; i < numTaps; i++)
+            {
+                int k = 2 * i - halfLength; // odd offsets from the centre tap
+                float ratio = static_cast<float>(k) / (halfLength + 1);
+                float window = besselI0(kaiserBeta * sqrtf(1.f - ratio * ratio)) / besselI0(kaiserBeta);
+                _coeffs[numTaps - 1 - i] = sinf(PI * k * 0.5f) / (PI * k) * window; // stored reversed for a forward dot product
+                sum += _coeffs[numTaps - 1 - i];
+            }
+            // normalise so DC gain is exactly 1 (centre tap 0.5 + odd branch 0.5)
+            for (float& c : _coeffs) c *= 0.5f / sum;
+        }
+
+        // allocate for blocks of up to maxFrames input frames (upsample) or output frames (downsample)
+        void prepare(int maxFrames)
+        {
+            _upBuffer.assign(_centre + maxFrames, 0.f);
+            _evenBuffer.assign(_centre + maxFrames, 0.f);
+            _oddBuffer.assign(_numTaps / 2 + maxFrames, 0.f);
+            _accumulator.assign(maxFrames, 0.f);
+        }
+
+        void reset()
+        {
+            std::fill(_upBuffer.begin(), _upBuffer.end(), 0.f);
+            std::fill(_evenBuffer.begin(), _evenBuffer.end(), 0.f);
+            std::fill(_oddBuffer.begin(), _oddBuffer.end(), 0.f);
+        }
+
+        // numFrames in --> 2 * numFrames out
+        void upsample(const float* in, float* out, int numFrames)
+        {
+            std::copy(in, in + numFrames, _upBuffer.data() + _centre);
+            convolveOddBranch(_upBuffer.data(), numFrames);
+
+            const int delay = _numTaps / 2; // centre tap lands halfway between odd branch outputs
+            for (int n = 0; n < numFrames; n++)
+            {
+                out[2*n+0] = 2.f * _accumulator[n]; // x2 to make up for the zero stuffed samples
+                out[2*n+1] = _upBuffer[n + delay];
+            }
+            std::copy(_upBuffer.data() + numFrames, _upBuffer.data() + numFrames + _centre, _upBuffer.data()); // keep history
+        }
+
+        // 2 * numFrames in --> numFrames out
+        void downsample(const float* in, float* out, int numFrames)
+        {
+            const int delay = _numTaps / 2;
+            for (int n = 0; n < numFrames; n++)
+            {
+                _evenBuffer[_centre + n] = in[2*n+0];
+                _oddBuffer[delay + n] = in[2*n+1];
+            }
+            convolveOddBranch(_evenBuffer.data(), numFrames);
+
+            for (int n = 0; n < numFrames; n++) out[n] = _accumulator[n] + 0.5f * _oddBuffer[n];
+
+            std::copy(_evenBuffer.data() + numFrames, _evenBuffer.data() + numFrames + _centre, _evenBuffer.data());
+            std::copy(_oddBuffer.data() + numFrames, _oddBuffer.data() + numFrames + delay, _oddBuffer.data());
+        }
+
+        // group delay in samples at the oversampled rate, for one direction
+        int getDelay() const { return _numTaps - 1; }
+
+    private:
+        // accumulate tap by tap across the block, so the inner loop is a plain multiply-add over
+            // contiguous samples with no reduction, which the compiler vectorises (NEON / SSE / AVX)
+        void convolveOddBranch(const float* history, int numFrames)
+        {
+            float* __restrict acc = _accumulator.data();
+            std::fill_n(acc, numFrames, 0.f);
+            for (int j = 0; j < _numTaps; j++)
+            {
+                const float c = _coeffs[j];
+                const float* __restrict x = history + j;
+                for (int n = 0; n < numFrames; n++) acc[n] += c * x[n];
+            }
+        }
+
+        // zeroth order modified Bessel function, for the Kaiser window
+        static float besselI0(float x)
+        {
+            float sum = 1.f;
+            float term = 1.f;
+            for (int k = 1; k < 32; k++)
+            {
+                term *= (x * 0.5f / k) * (x * 0.5f / k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        int _numTaps = 0;
+        int _centre = 0;
+        std::vector<float> _coeffs;
+        std::vector<float> _upBuffer;       // history + input block
+        std::vector<float> _evenBuffer;     // history + even input samples
+        std::vector<float> _oddBuffer;      // history + odd input samples
+        std::vector<float> _accumulator;    // odd branch output for one block
+};
+
+// ----------------------------------------------------------------------------------------------
+// 1x / 2x / 4x / 8x oversampling around any block kernel, built from cascaded half-band stages
+    // all buffers are allocated in prepare(), process() never allocates
+    // usage: oversampler.process(out, numFrames, [&](float* samples, int numSamples, int channel) { ... });
+// ----------------------------------------------------------------------------------------------
+class Oversampler
+{
+    public:
+        static constexpr int MAXSTAGES = 3; // 2^3 = 8x
+
+        // call outside of process(), e.g. from PluginState::prepare()
+        void prepare(int maxBlock, int numChannels = 2)
+        {
+            _maxBlock = maxBlock;
+            _numChannels = numChannels;
+            _stages.assign(numChannels * MAXSTAGES, HalfBandStage());
+            for (int ch = 0; ch < numChannels; ch++)
+            {
+                for (int s = 0; s < MAXSTAGES; s++)
+                {
+                    // later stages have a much wider transition band so need far fewer taps
+                    HalfBandStage& stage = _stages[ch * MAXSTAGES + s];
+                    stage.design(STAGETAPS[s]);
+                    stage.prepare(maxBlock << s);
+                }
+            }
+            _ping.assign(maxBlock << MAXSTAGES, 0.f);
+            _pong.assign(maxBlock << MAXSTAGES, 0.f);
+        }
+
+        // factor = 1, 2, 4 or 8. Call outside of process(), clears filter history
+        void setFactor(int factor)
+        {
+            _numStages = 0;
+            while ((1 << _numStages) < factor && _numStages < MAXSTAGES) _numStages++;
+            for (HalfBandStage& stage : _stages) stage.reset();
+        }
+        int getFactor() const { return 1 << _numStages; }
+
+        // round trip latency in samples at the base rate
+        float getLatency() const
+        {
+            float latency = 0.f;
+            for (int s = 0; s < _numStages; s++) latency += static_cast<float>(_stages[s].getDelay()) / (1 << s);
+            return latency;
+        }
+
+        // kernel(float* samples, int numSamples, int channel) is called once per channel at the oversampled rate
+        template <typename Kernel>
+        void process(float* interleaved, int numFrames, Kernel&& kernel)
+        {
+            for (int start = 0; start < numFrames; start += _maxBlock) // split blocks larger than prepared for
+            {
+                const int frames = std::min(_maxBlock, numFrames - start);
+                float* block = interleaved + start * _numChannels;
+                for (int ch = 0; ch < _numChannels; ch++)
+                {
+                    float* current = _ping.data();
+                    float* next = _pong.data();
+                    for (int i = 0; i < frames; i++) current[i] = block[i * _numChannels + ch]; // deinterleave
+
+                    int length = frames;
+                    for (int s = 0; s < _numStages; s++)
+                    {
+                        _stages[ch * MAXSTAGES + s].upsample(current, next, length);
+                        std::swap(current, next);
+                        length *= 2;
+                    }
+                    kernel(current, length, ch);
+                    for (int s = _numStages - 1; s >= 0; s--)
+                    {
+                        length /= 2;
+                        _stages[ch * MAXSTAGES + s].downsample(current, next, length);
+                        std::swap(current, next);
+                    }
+
+                    for (int i = 0; i < frames; i++) block[i * _numChannels + ch] = current[i]; // interleave
+                }
+            }
+        }
+
+    private:
+        static constexpr int STAGETAPS[MAXSTAGES] = { 32, 16, 8 }; // odd branch taps per stage (63, 31 & 15 tap filters)
+
+        int _maxBlock = 0;
+        int _numChannels = 0;
+        int _numStages = 0;
+        std::vector<HalfBandStage> _stages; // [channel * MAXSTAGES + stage]
+        std::vector<float> _ping;
+        std::vector<float> _pong;
+};
@@ -6,17 +6,64 @@
 // ----------------------------------------------------------------------------------------------
 #include "plugin.h"
 
+#include <new> // for placement new
+
+// ----------------------------------------------------------------------------------------------
+// Optional: builds the read-only tables shared by every instance, returns a void* pointer to them
+    // Called once when the module is loaded, before any instance is created
+    // resourceDir is the folder to load data files from: the repo root when live, a test script's folder in --test
+    // extern "C" to prevent stripping of symbol names
+// ----------------------------------------------------------------------------------------------
+extern "C" void* initModule(const char* resourceDir) { return new SharedTables(resourceDir); }
+
+// Frees the tables allocated in initModule(), called after every instance is destroyed
+extern "C" void deinitModule(void* shared) { delete static_cast<SharedTables*>(shared); }
+
 // ----------------------------------------------------------------------------------------------
 // Allocates a new PluginState object on the heap & returns a void* pointer to it
     // Called when the module is first loaded
-    // extern "C" to prevent stripping of symbol names
 // ----------------------------------------------------------------------------------------------
-extern "C" void* createPlugin(void* uiParamsPoint) { return new PluginState(uiParamsPoint); }
+extern "C" void* createPlugin(void* uiParamsPoint, const void* shared) { return new PluginState(uiParamsPoint, shared); }
 
 // Frees the memory allocated in createPlugin()
     // Called when the module is about to be unloaded (i.e. before hot-reload)
 extern "C" void destroyPlugin(void* state) { delete static_cast<PluginState*>(state); }
 
+// Optional: construct / destruct instances in memory owned by the host, so many instances can sit
+    // back to back in 1 arena. The host aligns each instance to 64 bytes
+static_assert(alignof(PluginState) <= 64, "the host's instance arena aligns to 64 bytes");
+extern "C" int pluginStateSize() { return sizeof(PluginState); }
+extern "C" void* createPluginAt(void* memory, void* uiParamsPoint, const void* shared) { return new (memory) PluginState(uiParamsPoint, shared); }
+extern "C" void destroyPluginAt(void* state) { static_cast<PluginState*>(state)->~PluginState(); }
+
+// Passes the stream's sampleRate & largest block size, so the plugin can preallocate
+    // & the instance's RealtimeArena to preallocate from (null for offline renders, the heap is used instead)
+    // Called after createPlugin() and again whenever the host reopens its audio stream
+extern "C" void preparePlugin(void* state, int sampleRate, int maxBlock, void* arena)
+{
+    static_cast<PluginState*>(state)->prepare(sampleRate, maxBlock, static_cast<RealtimeArena*>(arena));
+}
+
+// Optional: non-realtime housekeeping (e.g. starting background threads), never on the audio thread
+    // Called every ~200 ms on the host's main thread, whilst processPlugin() may be running
+extern "C" void idlePlugin(void* state)
+{
+    static_cast<PluginState*>(state)->idle();
+}
+
+// Optional: copy the plugin's state into buffer for session files, returns the bytes needed
+    // Called with a null buffer first to ask for the size
+extern "C" int saveStatePlugin(void* state, void* buffer, int capacity)
+{
+    return static_cast<PluginState*>(state)->saveState(buffer, capacity);
+}
+
+// Optional: restore state saved by saveStatePlugin(), called after preparePlugin() when a session is loaded
+extern "C" void loadStatePlugin(void* state, const void* data, int size)
+{
+    static_cast<PluginState*>(state)->loadState(data, size);
+}
+
 // DSP Code: Generates 'numFrames' samples into the 'out' buffer
     // Called once per audio block by host
 extern "C" void processPlugin(void* state, float* out, int numFrames) 
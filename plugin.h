@@ -5,7 +5,30 @@
 
 #include <atomic>
 #include <cmath> // for sinf() and M_PI
+#include <cstring> // for memcpy()
+#include <string>
 #include "globals.h"
+#include "oversampler.h"
+#include "convolver.h"
+#include "wavEncoder.h"
+#include "rtAllocator.h"
+
+// ----------------------------------------------------------------------------------------------
+// Read-only data built once per loaded module by initModule() & shared by every PluginState
+    // put large tables (wavetables, filter banks, ..) here so N instances don't mean N copies
+// ----------------------------------------------------------------------------------------------
+struct SharedTables
+{
+    explicit SharedTables(const char* resourceDir)
+    {
+        irLoaded = readWav(std::string(resourceDir ? resourceDir : ".") + "/" + IRFILE, irFile, irChannels, irSampleRate);
+    }
+
+    bool irLoaded = false;
+    std::vector<float> irFile; // IRFILE decoded, interleaved
+    int irChannels = 0;
+    int irSampleRate = 0;
+};
 
 // -------------------------------------------
 // Shared class to hold per-instance DSP State 
@@ -13,18 +36,74 @@
 class PluginState
 {
     public:
-        PluginState(void* uiParamsPoint) 
+        PluginState(void* uiParamsPoint, const void* sharedPoint) 
         { 
             _uiParams = static_cast<UiParams*>(uiParamsPoint); 
+            _shared = static_cast<const SharedTables*>(sharedPoint);
+        }
+
+        // Called before processing & whenever the stream's sampleRate or block size changes (never during process)
+            // preallocate any buffers here for blocks of up to maxBlock frames, from arena via ArenaVector / ArenaAllocator
+            // process() must never allocate: no new, push_back, resize, std::string, .. (check with cmake -DRT_ALLOC_CHECK=ON)
+        void prepare(int sampleRate, int maxBlock, RealtimeArena* arena)
+        {
+            _sampleRate = sampleRate;
+            _maxBlock = maxBlock;
+            ArenaAllocator<float> allocator(arena);
+            _oversampler.prepare(maxBlock);
+            _oversampler.setFactor(_oversampling);
+
+            // partition the shared impulse response for this sampleRate & block size, any length is fine
+            _irLoaded = _shared && _shared->irLoaded;
+            bool offline = _uiParams && _uiParams->offline.load(); // offline renders compute the tail inline, so they're repeatable
+            for (int ch = 0; ch < 2 && _irLoaded; ++ch)
+            {
+                std::vector<float> ir = extractImpulseResponse(_shared->irFile, _shared->irChannels, ch, _shared->irSampleRate, sampleRate);
+                _convolvers[ch].prepare(ir.data(), static_cast<int>(ir.size()), maxBlock, !offline);
+                _convolverIn[ch] = ArenaVector<float>(maxBlock, 0.f, allocator);
+                _convolverOut[ch] = ArenaVector<float>(maxBlock, 0.f, allocator);
+            }
+            idle(); // tail threads straight away if convolve is already on
+        }
+
+        // Called every ~200 ms on the host's main thread, whilst process() runs. For non-realtime chores
+            // here: start the convolvers' tail threads the first time convolve is switched on
+            // so instances that never convolve don't each keep 2 idle threads
+        void idle()
+        {
+            if (!_irLoaded || !_uiParams || !_uiParams->convolve.load()) return;
+            for (Convolver& convolver : _convolvers) convolver.startWorker();
+        }
+
+        // session files: save the oscillator & smoothed parameters, so a restored session picks up without glides
+            // returns the bytes needed, only writes when capacity is large enough
+        int saveState(void* buffer, int capacity)
+        {
+            float values[] = { _phase, _freq, _gain };
+            if (buffer && capacity >= static_cast<int>(sizeof(values))) std::memcpy(buffer, values, sizeof(values));
+            return sizeof(values);
+        }
+        void loadState(const void* data, int size)
+        {
+            float values[3];
+            if (size != sizeof(values)) return; // saved by a different version of the plugin, keep defaults
+            std::memcpy(values, data, sizeof(values));
+            _phase = values[0];
+            _freq = values[1];
+            _gain = values[2];
         }
 
         void process(float* out, int numFrames)
         {
             // assign ui's atomics to local variables for easier syntax within DSP calculations
             float bypass = 0;
+            bool saturate = false;
+            bool convolve = false;
             if (_uiParams)
             {
                 bypass = _uiParams->bypass.load();
+                saturate = _uiParams->saturate.load();
+                convolve = _uiParams->convolve.load();
             }
             // optional parameter smoothing
             constexpr float smoothing = 0.005f;
@@ -49,14 +128,39 @@ class PluginState
 
                 // sine wave oscillator @ amplitude 0.2
                 float output = !bypass * _gain * sinf(_phase);
-                out[2*i+0] = output; // Left channel
-                out[2*i+1] = output; // Right channel
+                for (int ch = 0; ch < CHANNELS; ++ch) out[CHANNELS*i+ch] = output; // interleaved Left, Right, ..
 
                 // advance phase for next sample
                 _phase += phaseInc;
                 // wrap around if phase exceeds 2π
                 if (_phase > twoPi) _phase -= twoPi;
             }
+
+            // optional nonlinear stage, oversampled to keep the added harmonics from aliasing
+            if (saturate)
+            {
+                float drive = _drive;
+                float makeUp = 1.f / tanhf(drive);
+                _oversampler.process(out, numFrames, [drive, makeUp](float* samples, int numSamples, int)
+                {
+                    for (int i = 0; i < numSamples; ++i) samples[i] = makeUp * tanhf(drive * samples[i]);
+                });
+            }
+
+            // optional reverb / cabinet, convolves with IRFILE (if it loaded)
+            if (convolve && _irLoaded)
+            {
+                for (int start = 0; start < numFrames; start += _maxBlock)
+                {
+                    int frames = std::min(_maxBlock, numFrames - start);
+                    for (int ch = 0; ch < CHANNELS; ++ch)
+                    {
+                        for (int i = 0; i < frames; ++i) _convolverIn[ch][i] = out[CHANNELS*(start+i)+ch];
+                        _convolvers[ch].process(_convolverIn[ch].data(), _convolverOut[ch].data(), frames);
+                        for (int i = 0; i < frames; ++i) out[CHANNELS*(start+i)+ch] = _convolverOut[ch][i];
+                    }
+                }
+            }
             // store any changed ui params
             if (_uiParams) 
             { 
@@ -64,11 +168,23 @@ class PluginState
             }
         }
     private:
-        int _sampleRate = SAMPLERATE; // sampleRate should match output stream sampleRate
+        static constexpr int CHANNELS = 2; // interleaved stereo, the oversampler & convolvers are prepared for 2
+        int _sampleRate = SAMPLERATE; // set by prepare() to match the output stream sampleRate
+        int _maxBlock = BUFFERFRAMES; // largest numFrames process() will be called with
         float _phase = 0.f;
         float _freq = 220.f;
         float _gain = 0.5f;
+        float _drive = 4.f; // saturator input gain
+
+        int _oversampling = 4; // 1, 2, 4 or 8, compare their cost & latency with: ./build/DSPlayground --bench
+        Oversampler _oversampler;
+
+        bool _irLoaded = false;
+        Convolver _convolvers[2]; // 1 per channel
+        ArenaVector<float> _convolverIn[2];
+        ArenaVector<float> _convolverOut[2];
 
         UiParams* _uiParams = nullptr;
+        const SharedTables* _shared = nullptr; // owned by the module, not the instance
 };
 
@@ -0,0 +1,300 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+// ----------------------------------------------------------------------------------------------
+// Remote control server. OSC-like text protocol, one message per line, replies are lines too
+    // /param <name> <value>            set 1 parameter, <name>@<n> addresses instance n (see --instances)
+    // /params <name> <value> ...       set several, applied together at the start of 1 audio block
+    // /get <name>                      --> /param <name> <value>
+    // /list                            --> /list <name> <name> ..
+    // /record                          export recording.wav of the last few seconds
+    // /reload                          rebuild & reload plugin.h
+    // /save                            write the session file
+    // /status                          --> /status <sampleRate> <bufferFrames> <latencyMs> <dspLoad>
+    // /meter                           --> /meter <rms> <peak>
+    // /overload                        --> /overload <deadlineMisses> <pluginTrips> <tripped 0/1>
+    // /scope <frames>                  --> /scope <sample> .. (latest mono output, up to 4096 frames)
+    // /subscribe <ms>                  stream /meter every <ms> milliseconds, 0 stops
+    // errors                           --> /error <message>
+//
+// e.g. echo "/params freq 440 gain 0.3" | socat - UNIX-CONNECT:/tmp/dsplayground.sock
+// ----------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "remote.h"
+#include "wavEncoder.h"
+
+#if defined(MSG_NOSIGNAL)
+constexpr int SENDFLAGS = MSG_NOSIGNAL; // don't die of SIGPIPE when a script disconnects early
+#else
+constexpr int SENDFLAGS = 0; // macOS, SO_NOSIGPIPE is set per socket instead
+#endif
+
+constexpr int MAXBATCH = 64; // parameter changes per /params message
+constexpr int MAXSCOPEFRAMES = 4096;
+constexpr std::size_t MAXCLIENTBUFFER = 1 << 20; // clients that stop reading are dropped
+
+struct RemoteClient
+{
+    int fd = -1;
+    std::string input;
+    std::string output;
+    int meterIntervalMs = 0;
+    std::chrono::steady_clock::time_point nextMeter;
+};
+
+static void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#if defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+static std::string meterMessage(Globals& globals)
+{
+    char line[64];
+    std::snprintf(line, sizeof(line), "/meter %.6f %.6f\n", globals.meterRms.load(), globals.meterPeak.load());
+    return line;
+}
+
+// ms until the nearest /subscribe meter is due, -1 (sleep until a socket is ready) if nobody subscribed
+static int pollTimeout(const std::vector<RemoteClient>& clients)
+{
+    auto now = std::chrono::steady_clock::now();
+    int timeout = -1;
+    for (const RemoteClient& client : clients)
+    {
+        if (client.meterIntervalMs <= 0) continue;
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(client.nextMeter - now).count();
+        int due = static_cast<int>(std::max<decltype(wait)>(wait, 0));
+        timeout = timeout < 0 ? due : std::min(timeout, due);
+    }
+    return timeout;
+}
+
+// handle 1 message, returns the reply (may be empty)
+static std::string handleMessage(const std::string& message, RemoteClient& client, LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
+{
+    std::istringstream words(message);
+    std::string address;
+    if (!(words >> address)) return "";
+
+    if (address == "/param" || address == "/params")
+    {
+        ParamChange batch[MAXBATCH];
+        int count = 0;
+        std::string name;
+        float value = 0.f;
+        while (words >> name)
+        {
+            if (!(words >> value)) return "/error missing value for " + name + "\n";
+            // name@instance, instance 0 (the UI's) by default
+            int instance = 0;
+            std::size_t at = name.find('@');
+            if (at != std::string::npos)
+            {
+                instance = std::atoi(name.c_str() + at + 1);
+                name.erase(at);
+                if (instance < 0 || instance >= globals.numInstances.load()) return "/error no instance " + std::to_string(instance) + "\n";
+            }
+            int id = UiParams::find(name);
+            if (id < 0) return "/error unknown parameter " + name + "\n";
+            if (count == MAXBATCH) return "/error more than " + std::to_string(MAXBATCH) + " parameters\n";
+            batch[count++] = { id, value, instance };
+        }
+        if (count == 0) return "/error " + address + " expects <name> <value> pairs\n";
+        // all or nothing, so the whole batch lands in the same audio block
+        if (!globals.paramQueue.push(batch, count)) return "/error parameter queue full, slow down\n";
+        return "";
+    }
+    if (address == "/get")
+    {
+        std::string name;
+        words >> name;
+        int id = UiParams::find(name);
+        if (id < 0) return "/error unknown parameter " + name + "\n";
+        return "/param " + name + " " + std::to_string(uiParams.get(id)) + "\n";
+    }
+    if (address == "/list")
+    {
+        std::string reply = "/list";
+        for (const char* name : PARAMNAMES) reply += std::string(" ") + name;
+        return reply + "\n";
+    }
+    if (address == "/record")
+    {
+        std::thread wavWrite(wavWriteThread);
+        wavWrite.detach(); // run independently
+        return "";
+    }
+    if (address == "/reload")
+    {
+        logBuff.setNewLine("Remote control: reload requested");
+        globals.reloadRequested.store(1);
+        return "";
+    }
+    if (address == "/save")
+    {
+        globals.saveSession.store(1);
+        return "";
+    }
+    if (address == "/status")
+    {
+        char line[128];
+        std::snprintf(line, sizeof(line), "/status %d %d %.2f %.4f\n", globals.sampleRate.load(), globals.bufferFrames.load(), 
+                      globals.latencyMs.load(), globals.dspLoad.load());
+        return line;
+    }
+    if (address == "/meter") return meterMessage(globals);
+    if (address == "/overload")
+    {
+        char line[128];
+        std::snprintf(line, sizeof(line), "/overload %d %d %d\n", globals.deadlineMisses.load(), globals.pluginTrips.load(), 
+                      globals.pluginTripped.load() ? 1 : 0);
+        return line;
+    }
+    if (address == "/scope")
+    {
+        int frames = 0;
+        words >> frames;
+        frames = std::clamp(frames, 1, MAXSCOPEFRAMES);
+        int size = globals.circularOutput.size();
+        int readHead = ((globals.writeHead.load() - frames) % size + size) % size;
+        std::string reply = "/scope";
+        char sample[16];
+        for (int i = 0; i < frames; i++)
+        {
+            std::snprintf(sample, sizeof(sample), " %.6f", globals.circularOutput[(readHead + i) % size]);
+            reply += sample;
+        }
+        return reply + "\n";
+    }
+    if (address == "/subscribe")
+    {
+        client.meterIntervalMs = 0;
+        words >> client.meterIntervalMs;
+        client.meterIntervalMs = std::max(client.meterIntervalMs, 0);
+        client.nextMeter = std::chrono::steady_clock::now();
+        return "";
+    }
+    return "/error unknown address " + address + "\n";
+}
+
+void runRemoteServer(const std::string& socketPath, LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        logBuff.setNewLine("Remote socket path too long: " + socketPath);
+        return;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    // only remove a socket left over from a previous run, never a regular file at a mistyped --remote path
+    struct stat existing;
+    if (lstat(socketPath.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            logBuff.setNewLine("Remote control failed: " + socketPath + " exists and isn't a socket");
+            return;
+        }
+        unlink(socketPath.c_str());
+    }
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0 || bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server, 8) != 0)
+    {
+        logBuff.setNewLine("Remote control failed on " + socketPath + ": " + std::strerror(errno));
+        if (server >= 0) close(server);
+        return;
+    }
+    setNonBlocking(server);
+    logBuff.setNewLine("Remote control listening on " + socketPath);
+
+    std::vector<RemoteClient> clients;
+    std::vector<pollfd> fds;
+    char buffer[4096];
+    while (true)
+    {
+        // wake for new connections, incoming messages, writable clients with pending replies, or meter streams
+        fds.clear();
+        fds.push_back({ server, POLLIN, 0 });
+        for (RemoteClient& client : clients) fds.push_back({ client.fd, static_cast<short>(POLLIN | (client.output.empty() ? 0 : POLLOUT)), 0 });
+        poll(fds.data(), fds.size(), pollTimeout(clients));
+
+        if (fds[0].revents & POLLIN)
+        {
+            int fd;
+            while ((fd = accept(server, nullptr, nullptr)) >= 0)
+            {
+                setNonBlocking(fd);
+                RemoteClient client;
+                client.fd = fd;
+                clients.push_back(std::move(client));
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < clients.size(); i++)
+        {
+            RemoteClient& client = clients[i];
+            bool closed = false;
+            short events = i + 1 < fds.size() ? fds[i + 1].revents : 0; // clients accepted this round have no poll entry yet
+
+            if (events & (POLLIN | POLLHUP | POLLERR))
+            {
+                ssize_t received;
+                while ((received = recv(client.fd, buffer, sizeof(buffer), 0)) > 0) client.input.append(buffer, received);
+                if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) closed = true;
+
+                // handle every complete line
+                std::size_t newline;
+                while ((newline = client.input.find('\n')) != std::string::npos)
+                {
+                    client.output += handleMessage(client.input.substr(0, newline), client, logBuff, globals, uiParams);
+                    client.input.erase(0, newline + 1);
+                }
+            }
+            if (client.meterIntervalMs > 0 && now >= client.nextMeter)
+            {
+                client.output += meterMessage(globals);
+                client.nextMeter = now + std::chrono::milliseconds(client.meterIntervalMs);
+            }
+            if (!client.output.empty())
+            {
+                ssize_t sent = send(client.fd, client.output.data(), client.output.size(), SENDFLAGS);
+                if (sent > 0) client.output.erase(0, sent);
+                else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) closed = true;
+            }
+            if (client.input.size() > MAXCLIENTBUFFER || client.output.size() > MAXCLIENTBUFFER) closed = true;
+
+            if (closed)
+            {
+                close(client.fd);
+                client.fd = -1;
+            }
+        }
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const RemoteClient& client) { return client.fd < 0; }), clients.end());
+    }
+}
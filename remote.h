@@ -0,0 +1,11 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include "globals.h"
+
+// Scriptable remote control over a local UNIX domain socket, blocks so run it on its own thread
+    // parameter changes reach the audio thread through Globals::paramQueue, never blocking it
+void runRemoteServer(const std::string& socketPath, LogBuffer& logBuff, Globals& globals, UiParams& uiParams);
@@ -0,0 +1,121 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <algorithm>
+#include <dlfcn.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "render.h"
+
+// Get platform-specific shared library filename
+static std::string sharedLibraryName(const std::string& baseName)
+{
+#if defined(_WIN32) // Windows
+    return baseName + ".dll";
+#elif defined(__APPLE__) && defined(__MACH__) // macOS
+    return "lib" + baseName + ".dylib";
+#elif defined(__linux__) // Linux
+    return "lib" + baseName + ".so";
+#else
+    #error Unsupported platform
+#endif
+}
+
+bool openPluginModule(PluginModule& module, std::string& error, int version, const std::string& resourceDir)
+{
+    std::string pluginPath = BUILDDIR "/plugins/" + sharedLibraryName("plugin");
+    if (version > 0)
+    {
+        // dlopen hands back the already loaded library for a path it has seen, so each version gets its own file
+        std::string versionPath = BUILDDIR "/plugins/" + sharedLibraryName("plugin." + std::to_string(version));
+        std::error_code copyError;
+        std::filesystem::copy_file(pluginPath, versionPath, std::filesystem::copy_options::overwrite_existing, copyError);
+        if (copyError)
+        {
+            error = "Failed to copy Plugin: " + copyError.message();
+            return false;
+        }
+        pluginPath = versionPath;
+    }
+    // Try to open the shared library file
+    void* handle = dlopen(pluginPath.c_str(), RTLD_NOW);
+    if (version > 0) std::filesystem::remove(pluginPath); // stays mapped whilst loaded
+    if (!handle) // null ptr check
+    {
+        error = std::string("Failed to load Plugin: ") + dlerror();
+        return false;
+    }
+
+    // Resolve the symbols (function names) expected from plugin.cpp
+        // strings and types must match what's declared in plugin.h and implemented in plugin.cpp
+    auto createFn  = (void* (*)(void*, const void*))dlsym(handle, "createPlugin");
+    auto destroyFn = (void (*)(void*))dlsym(handle, "destroyPlugin");
+    auto prepareFn = (void (*)(void*, int, int, void*))dlsym(handle, "preparePlugin");
+    auto processFn = (void (*)(void*, float*, int))dlsym(handle, "processPlugin");
+
+    // Check all functions were found
+    if (!createFn || !destroyFn || !prepareFn || !processFn) 
+    {
+        error = std::string("Invalid Plugin symbols: ") + dlerror();
+        dlclose(handle);
+        return false;
+    }
+
+    module.handle  = handle;
+    module.create  = createFn;
+    module.destroy = destroyFn;
+    module.prepare = prepareFn;
+    module.process = processFn;
+
+    // Optional state (de)serialisation for session files
+    module.saveState = (int (*)(void*, void*, int))dlsym(handle, "saveStatePlugin");
+    module.loadState = (void (*)(void*, const void*, int))dlsym(handle, "loadStatePlugin");
+
+    // Optional main thread housekeeping, e.g. starting background threads on demand
+    module.idle = (void (*)(void*))dlsym(handle, "idlePlugin");
+
+    // Optional placement into a host owned arena, for hosting many instances
+    auto stateSizeFn = (int (*)())dlsym(handle, "pluginStateSize");
+    module.stateSize = stateSizeFn ? stateSizeFn() : 0;
+    module.createAt = (void* (*)(void*, void*, const void*))dlsym(handle, "createPluginAt");
+    module.destroyAt = (void (*)(void*))dlsym(handle, "destroyPluginAt");
+
+    // Optional read-only tables, built once here & shared by every instance created from this module
+    module.initModule = (void* (*)(const char*))dlsym(handle, "initModule");
+    module.deinitModule = (void (*)(void*))dlsym(handle, "deinitModule");
+    module.shared = module.initModule ? module.initModule(resourceDir.c_str()) : nullptr;
+    return true;
+}
+
+void closePluginModule(PluginModule& module)
+{
+    if (module.deinitModule && module.shared) module.deinitModule(module.shared);
+    module.shared = nullptr;
+    if (module.handle) dlclose(module.handle);
+    module.handle = nullptr;
+}
+
+void renderPlugin(const PluginModule& module, UiParams& params, const std::vector<ParamEvent>& events,
+                  int sampleRate, int blockSize, int numFrames, std::vector<float>& out)
+{
+    params.offline.store(true);
+    void* state = module.create(&params, module.shared);
+    module.prepare(state, sampleRate, blockSize, nullptr); // offline, plain heap memory is fine
+
+    out.assign(numFrames * 2, 0.f); // interleaved stereo
+    std::size_t nextEvent = 0;
+    for (int start = 0; start < numFrames; start += blockSize)
+    {
+        // apply every event due by the end of this block's first frame
+        while (nextEvent < events.size() && events[nextEvent].frame <= start)
+        {
+            params.set(events[nextEvent].param, events[nextEvent].value);
+            nextEvent++;
+        }
+        int frames = std::min(blockSize, numFrames - start);
+        module.process(state, out.data() + start * 2, frames);
+    }
+    module.destroy(state);
+}
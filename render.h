@@ -0,0 +1,31 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "globals.h"
+
+// dlopen the plugin shared library & resolve its symbols into module, module.state is left untouched
+    // also builds the module's shared tables (initModule), so call once per module, not per instance
+    // version > 0 loads a private copy of the library, so several builds can stay loaded side by side
+    // resourceDir is where initModule looks for data files such as IRFILE, e.g. a test script's folder
+bool openPluginModule(PluginModule& module, std::string& error, int version = 0, const std::string& resourceDir = ".");
+
+// free the shared tables & dlclose, every instance created from module must already be destroyed
+void closePluginModule(PluginModule& module);
+
+// a parameter change at a given frame of an offline render
+struct ParamEvent
+{
+    int frame = 0;
+    int param = 0; // index into PARAMNAMES
+    float value = 0.f;
+};
+
+// render numFrames of interleaved stereo from a fresh plugin instance, no audio device needed
+    // events are applied at the start of the first block at or after their frame
+    // params.offline is set so plugins render deterministically
+void renderPlugin(const PluginModule& module, UiParams& params, const std::vector<ParamEvent>& events,
+                  int sampleRate, int blockSize, int numFrames, std::vector<float>& out);
@@ -0,0 +1,157 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+// ----------------------------------------------------------------------------------------------
+// Realtime safe memory for plugins: 1 preallocated, pre-faulted block per instance
+    // requests are rounded up to a power of 2 size class, freed blocks go on that class's free list
+    // & new blocks are bumped off the end, so allocate() / deallocate() never lock, syscall or page fault
+    // single threaded: the host only uses an instance's arena from prepare() & process(), never both at once
+    // when full, allocations fall back to the heap & are counted, so an undersized arena never crashes the stream
+// ----------------------------------------------------------------------------------------------
+class RealtimeArena
+{
+    public:
+        static constexpr int MINCLASS = 4;      // 16 bytes
+        static constexpr int NUMCLASSES = 40;   // up to 2^43 bytes, more than any arena
+
+        RealtimeArena() = default;
+        RealtimeArena(const RealtimeArena&) = delete;
+        RealtimeArena& operator=(const RealtimeArena&) = delete;
+        ~RealtimeArena() { release(); }
+
+        // map capacity bytes & touch every page now, so the audio thread never takes a page fault
+            // also locks them in RAM where allowed (RLIMIT_MEMLOCK), call outside of the audio thread
+        bool reserve(std::size_t capacity)
+        {
+            release();
+            void* memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) return false;
+            const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            for (std::size_t offset = 0; offset < capacity; offset += pageSize) static_cast<volatile char*>(memory)[offset] = 0;
+            mlock(memory, capacity); // best effort
+            _begin = static_cast<char*>(memory);
+            _end = _begin + capacity;
+            _top = _begin;
+            return true;
+        }
+
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            const int sizeClass = classOf(bytes < alignment ? alignment : bytes);
+            FreeBlock*& freeList = _freeLists[sizeClass];
+            if (freeList && (reinterpret_cast<std::uintptr_t>(freeList) & (alignment - 1)) == 0) // reuse a freed block of the same class
+            {
+                FreeBlock* block = freeList;
+                freeList = block->next;
+                return block;
+            }
+
+            // bump a new block, aligned to its own size up to a cache line, or more when asked (e.g. page aligned FFT buffers)
+            const std::size_t size = std::size_t(1) << sizeClass;
+            const std::size_t blockAlign = std::max(size < 64 ? size : 64, alignment);
+            char* block = _begin + ((_top - _begin + blockAlign - 1) & ~(blockAlign - 1));
+            if (!_begin || block + size > _end)
+            {
+                _fallbacks.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(bytes, std::align_val_t(alignment));
+            }
+            _top = block + size;
+            return block;
+        }
+
+        void deallocate(void* pointer, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            if (!pointer) return;
+            if (!owns(pointer))
+            {
+                ::operator delete(pointer, std::align_val_t(alignment));
+                return;
+            }
+            FreeBlock* block = static_cast<FreeBlock*>(pointer);
+            FreeBlock*& freeList = _freeLists[classOf(bytes < alignment ? alignment : bytes)];
+            block->next = freeList;
+            freeList = block;
+        }
+
+        bool owns(const void* pointer) const { return pointer >= _begin && pointer < _end; }
+        std::size_t capacity() const { return _end - _begin; }
+        std::size_t used() const { return _top - _begin; } // high water mark, freed blocks stay on their free lists
+        int fallbacks() const { return _fallbacks.load(std::memory_order_relaxed); } // heap allocations because the arena was full, any thread
+
+    private:
+        struct FreeBlock { FreeBlock* next; };
+
+        // smallest power of 2 >= bytes, at least 2^MINCLASS
+        static int classOf(std::size_t bytes)
+        {
+            int sizeClass = MINCLASS;
+            while ((std::size_t(1) << sizeClass) < bytes) sizeClass++;
+            return sizeClass;
+        }
+
+        void release()
+        {
+            if (_begin) munmap(_begin, _end - _begin);
+            _begin = _end = _top = nullptr;
+            std::memset(_freeLists, 0, sizeof(_freeLists));
+            _fallbacks.store(0);
+        }
+
+        char* _begin = nullptr;
+        char* _end = nullptr;
+        char* _top = nullptr;                   // next unused byte
+        FreeBlock* _freeLists[NUMCLASSES] = {}; // [size class], singly linked through the free blocks themselves
+        std::atomic<int> _fallbacks = 0;
+};
+
+// ----------------------------------------------------------------------------------------------
+// STL allocator over a RealtimeArena, e.g. ArenaVector<float> buffer(maxBlock, 0.f, ArenaAllocator<float>(arena));
+    // a null arena uses the heap, so the same code runs in offline renders that don't pass one
+// ----------------------------------------------------------------------------------------------
+template <typename T>
+class ArenaAllocator
+{
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator() = default;
+        explicit ArenaAllocator(RealtimeArena* arena) : _arena(arena) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena()) {}
+
+        T* allocate(std::size_t count)
+        {
+            if (!_arena) return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+            return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+        void deallocate(T* pointer, std::size_t count)
+        {
+            if (!_arena) ::operator delete(pointer, std::align_val_t(alignof(T)));
+            else _arena->deallocate(pointer, count * sizeof(T), alignof(T));
+        }
+
+        RealtimeArena* arena() const { return _arena; }
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return _arena == other.arena(); }
+
+    private:
+        RealtimeArena* _arena = nullptr;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
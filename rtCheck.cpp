@@ -0,0 +1,166 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include "rtCheck.h"
+
+#if !defined(RT_ALLOC_CHECK)
+
+void installAllocationCheck(LogBuffer&) {}
+int logAudioThreadAllocations(LogBuffer&) { return 0; }
+
+#else
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <execinfo.h>
+#include <new>
+#include <set>
+#include <string>
+#include "mpscQueue.h"
+
+constexpr int MAXSTACKDEPTH = 16;
+constexpr int LOGGEDFRAMES = 8; // per report, the innermost frames are the allocator itself
+
+struct AllocationReport
+{
+    std::size_t bytes = 0;
+    bool freed = false; // free() rather than an allocation, bytes unknown
+    int depth = 0;
+    void* frames[MAXSTACKDEPTH];
+};
+
+static thread_local bool onAudioThread = false;
+static thread_local bool inReport = false; // backtrace() mustn't report itself
+static MpscQueue<AllocationReport, 64> reports; // callback & plugin worker threads --> main thread
+static std::atomic<int> allocationCount = 0;
+static std::atomic<int> droppedReports = 0;
+
+AudioThreadScope::AudioThreadScope() : _outer(onAudioThread) { onAudioThread = true; }
+AudioThreadScope::~AudioThreadScope() { onAudioThread = _outer; }
+
+static void reportAllocation(std::size_t bytes, bool freed = false)
+{
+    if (!onAudioThread || inReport) return;
+    inReport = true;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    AllocationReport report;
+    report.bytes = bytes;
+    report.freed = freed;
+    report.depth = backtrace(report.frames, MAXSTACKDEPTH);
+    if (!reports.push(report)) droppedReports.fetch_add(1, std::memory_order_relaxed);
+    inReport = false;
+}
+
+void installAllocationCheck(LogBuffer& logBuff)
+{
+    // the first backtrace() loads its unwinder & allocates, get that out of the way off the audio thread
+    void* frames[MAXSTACKDEPTH];
+    backtrace(frames, MAXSTACKDEPTH);
+    logBuff.setNewLine("Audio thread allocation check enabled");
+}
+
+int logAudioThreadAllocations(LogBuffer& logBuff)
+{
+    static std::set<std::string> seen; // each distinct call stack is logged once
+    AllocationReport report;
+    while (reports.pop(report))
+    {
+        char** symbols = backtrace_symbols(report.frames, report.depth);
+        if (!symbols) continue;
+        std::string stack;
+        for (int i = 1; i < report.depth && i <= LOGGEDFRAMES; i++) stack += std::string("\n    ") + symbols[i]; // skip the reporting frame
+        std::free(symbols);
+        if (!seen.insert(stack).second) continue;
+        if (report.freed) logBuff.setNewLine("FREE ON THE AUDIO THREAD:" + stack);
+        else logBuff.setNewLine("ALLOCATION ON THE AUDIO THREAD (" + std::to_string(report.bytes) + " bytes):" + stack);
+    }
+    int dropped = droppedReports.exchange(0);
+    if (dropped) logBuff.setNewLine(std::to_string(dropped) + " more audio thread allocations not traced");
+    return allocationCount.load();
+}
+
+// ----------------------------------------------------------------------------------------------
+// Interception. glibc lets the executable replace malloc & friends, which also catches new, C code
+    // & the plugin library. Aligned allocations all land in __libc_memalign, frees are reported too
+    // as they take the same locks. Elsewhere (macOS) the replaceable global operator new is used
+// ----------------------------------------------------------------------------------------------
+#if defined(__GLIBC__)
+
+extern "C" void* __libc_malloc(std::size_t);
+extern "C" void* __libc_calloc(std::size_t, std::size_t);
+extern "C" void* __libc_realloc(void*, std::size_t);
+extern "C" void* __libc_memalign(std::size_t, std::size_t);
+extern "C" void __libc_free(void*);
+
+extern "C" void* malloc(std::size_t bytes)
+{
+    reportAllocation(bytes);
+    return __libc_malloc(bytes);
+}
+extern "C" void* calloc(std::size_t count, std::size_t bytes)
+{
+    reportAllocation(count * bytes);
+    return __libc_calloc(count, bytes);
+}
+extern "C" void* realloc(void* pointer, std::size_t bytes)
+{
+    reportAllocation(bytes);
+    return __libc_realloc(pointer, bytes);
+}
+extern "C" void* memalign(std::size_t alignment, std::size_t bytes)
+{
+    reportAllocation(bytes);
+    return __libc_memalign(alignment, bytes);
+}
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t bytes)
+{
+    reportAllocation(bytes);
+    return __libc_memalign(alignment, bytes);
+}
+extern "C" int posix_memalign(void** pointer, std::size_t alignment, std::size_t bytes)
+{
+    // same checks as glibc's: a power of 2 multiple of sizeof(void*)
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0) return EINVAL;
+    reportAllocation(bytes);
+    void* memory = __libc_memalign(alignment, bytes);
+    if (!memory) return ENOMEM;
+    *pointer = memory;
+    return 0;
+}
+extern "C" void free(void* pointer)
+{
+    if (pointer) reportAllocation(0, true);
+    __libc_free(pointer);
+}
+
+#else
+
+void* operator new(std::size_t bytes)
+{
+    reportAllocation(bytes);
+    if (void* pointer = std::malloc(bytes)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t bytes) { return operator new(bytes); }
+void* operator new(std::size_t bytes, std::align_val_t alignment)
+{
+    reportAllocation(bytes);
+    void* pointer = nullptr;
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    if (posix_memalign(&pointer, align, bytes) == 0) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment) { return operator new(bytes, alignment); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+#endif
+#endif
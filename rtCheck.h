@@ -0,0 +1,34 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include "globals.h"
+
+// ----------------------------------------------------------------------------------------------
+// Debug build option (cmake -DRT_ALLOC_CHECK=ON): report heap allocations made on the audio thread
+    // malloc / new are intercepted, audio threads record the call stack into a lock-free queue
+    // & the main thread logs each distinct call stack once. Compiles to nothing when the option is off
+// ----------------------------------------------------------------------------------------------
+
+// mark the current thread as an audio thread for the lifetime of the scope, e.g. at the top of the callback
+    // or around a plugin worker's process(). Scopes nest, the outer one stays in effect
+class AudioThreadScope
+{
+    public:
+#if defined(RT_ALLOC_CHECK)
+        AudioThreadScope();
+        ~AudioThreadScope();
+    private:
+        bool _outer; // the thread was already marked when this scope opened
+#else
+        AudioThreadScope() {} // user provided, so an unused scope doesn't warn
+        ~AudioThreadScope() {}
+#endif
+};
+
+// call once at startup, before the audio stream starts
+void installAllocationCheck(LogBuffer& logBuff);
+
+// main thread: log call stacks recorded since the last call, returns the total number of audio thread allocations
+int logAudioThreadAllocations(LogBuffer& logBuff);
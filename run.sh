@@ -4,4 +4,4 @@
 
 # Runs dspPlayground executable
 echo "Running DSPlayground.."
-./build/DSPlayground
+./build/DSPlayground "$@" # forward flags, e.g. ./run.sh --rate 96000 --block 128
@@ -0,0 +1,256 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "session.h"
+
+constexpr char SESSIONMAGIC[4] = { 'D', 'S', 'P', 'S' };
+constexpr std::uint32_t SESSIONVERSION = 1;
+
+// -- Writing -----------------------------------------------------------------
+static void putU32(std::vector<unsigned char>& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; i++) out.push_back((value >> (8 * i)) & 0xFF);
+}
+static void putFloat(std::vector<unsigned char>& out, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+static void putString(std::vector<unsigned char>& out, const std::string& text)
+{
+    putU32(out, static_cast<std::uint32_t>(text.size()));
+    out.insert(out.end(), text.begin(), text.end());
+}
+static void putParams(std::vector<unsigned char>& out, const Session::Params& params)
+{
+    putU32(out, static_cast<std::uint32_t>(params.size()));
+    for (const auto& [name, value] : params)
+    {
+        putString(out, name);
+        putFloat(out, value);
+    }
+}
+static void putSection(std::vector<unsigned char>& out, const char tag[4], const std::vector<unsigned char>& payload)
+{
+    out.insert(out.end(), tag, tag + 4);
+    putU32(out, static_cast<std::uint32_t>(payload.size()));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+// -- Reading, every read is bounds checked ------------------------------------
+struct Reader
+{
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t pos = 0;
+    bool ok = true;
+
+    std::uint32_t u32()
+    {
+        if (pos + 4 > size) { ok = false; return 0; }
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(data[pos + i]) << (8 * i);
+        pos += 4;
+        return value;
+    }
+    float f32()
+    {
+        std::uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string string()
+    {
+        std::uint32_t length = u32();
+        if (!ok || pos + length > size) { ok = false; return ""; }
+        std::string text(reinterpret_cast<const char*>(data + pos), length);
+        pos += length;
+        return text;
+    }
+};
+
+Session captureSession(const std::vector<const UiParams*>& params, const HostConfig& config, 
+                       const std::vector<std::vector<unsigned char>>& pluginStates)
+{
+    Session session;
+    for (const UiParams* instance : params)
+    {
+        Session::Params& values = session.params.emplace_back();
+        for (int id = 0; id < NUMPARAMS; id++) values.push_back({ PARAMNAMES[id], instance->get(id) });
+    }
+    session.stream = config;
+    session.hasStream = true;
+    session.pluginStates = pluginStates;
+    return session;
+}
+
+bool saveSession(const std::string& path, const Session& session, std::string& error)
+{
+    std::vector<unsigned char> bytes(SESSIONMAGIC, SESSIONMAGIC + 4);
+    putU32(bytes, SESSIONVERSION);
+
+    std::vector<unsigned char> payload;
+    putParams(payload, session.params.empty() ? Session::Params() : session.params[0]);
+    putSection(bytes, "PARM", payload);
+    for (std::size_t i = 1; i < session.params.size(); i++)
+    {
+        payload.clear();
+        putU32(payload, static_cast<std::uint32_t>(i));
+        putParams(payload, session.params[i]);
+        putSection(bytes, "IPRM", payload);
+    }
+
+    if (session.hasStream)
+    {
+        payload.clear();
+        putString(payload, session.stream.device);
+        putU32(payload, session.stream.sampleRate);
+        putU32(payload, session.stream.bufferFrames);
+        putU32(payload, session.stream.recordDuration);
+        putSection(bytes, "STRM", payload);
+    }
+    if (!session.pluginStates.empty() && !session.pluginStates[0].empty()) putSection(bytes, "PLUG", session.pluginStates[0]);
+    for (std::size_t i = 1; i < session.pluginStates.size(); i++)
+    {
+        if (session.pluginStates[i].empty()) continue;
+        payload.clear();
+        putU32(payload, static_cast<std::uint32_t>(i));
+        payload.insert(payload.end(), session.pluginStates[i].begin(), session.pluginStates[i].end());
+        putSection(bytes, "IPLG", payload);
+    }
+
+    // write everything to a temporary file, flush it to disk, then atomically replace the old session
+    std::string tempPath = path + ".tmp";
+    int file = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+    {
+        error = "can't write " + tempPath;
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < bytes.size())
+    {
+        ssize_t result = write(file, bytes.data() + written, bytes.size() - written);
+        if (result <= 0) break;
+        written += result;
+    }
+    bool ok = written == bytes.size() && fsync(file) == 0;
+    close(file);
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        error = "failed to save session " + path;
+        return false;
+    }
+    return true;
+}
+
+bool loadSession(const std::string& path, Session& session, std::string& error)
+{
+    error = "";
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return false; // no session yet
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size < 8)
+    {
+        close(file);
+        error = path + " is not a session file";
+        return false;
+    }
+    // map rather than read, the file is parsed straight from the page cache
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapped == MAP_FAILED)
+    {
+        error = "can't map " + path;
+        return false;
+    }
+
+    Reader reader{ static_cast<const unsigned char*>(mapped), static_cast<std::size_t>(info.st_size) };
+    bool valid = std::memcmp(reader.data, SESSIONMAGIC, 4) == 0;
+    reader.pos = 4;
+    std::uint32_t version = reader.u32();
+    if (!valid || version > SESSIONVERSION)
+    {
+        munmap(mapped, info.st_size);
+        error = path + " is not a session file (or is from a newer version)";
+        return false;
+    }
+
+    session = Session();
+    while (reader.ok && reader.pos + 8 <= reader.size)
+    {
+        std::string tag(reinterpret_cast<const char*>(reader.data + reader.pos), 4);
+        reader.pos += 4;
+        std::uint32_t size = reader.u32();
+        if (reader.pos + size > reader.size)
+        {
+            reader.ok = false;
+            break;
+        }
+        Reader section{ reader.data + reader.pos, size };
+        reader.pos += size;
+
+        if (tag == "PARM" || tag == "IPRM")
+        {
+            std::uint32_t instance = tag == "IPRM" ? section.u32() : 0;
+            if (instance >= static_cast<std::uint32_t>(MAXINSTANCES)) continue; // from a build hosting more, skip
+            if (session.params.size() <= instance) session.params.resize(instance + 1);
+            std::uint32_t count = section.u32();
+            for (std::uint32_t i = 0; i < count && section.ok; i++)
+            {
+                std::string name = section.string();
+                float value = section.f32();
+                if (section.ok) session.params[instance].push_back({ name, value });
+            }
+        }
+        else if (tag == "STRM")
+        {
+            session.stream.device = section.string();
+            session.stream.sampleRate = static_cast<int>(section.u32());
+            session.stream.bufferFrames = static_cast<int>(section.u32());
+            session.stream.recordDuration = static_cast<int>(section.u32());
+            session.hasStream = section.ok 
+                && session.stream.sampleRate >= static_cast<int>(MINSAMPLERATE) && session.stream.sampleRate <= static_cast<int>(MAXSAMPLERATE)
+                && session.stream.bufferFrames >= static_cast<int>(MINBUFFERFRAMES) && session.stream.bufferFrames <= static_cast<int>(MAXBUFFERFRAMES)
+                && session.stream.recordDuration >= 1 && session.stream.recordDuration <= 60;
+        }
+        else if (tag == "PLUG" || tag == "IPLG")
+        {
+            std::uint32_t instance = tag == "IPLG" ? section.u32() : 0;
+            if (instance >= static_cast<std::uint32_t>(MAXINSTANCES)) continue;
+            if (session.pluginStates.size() <= instance) session.pluginStates.resize(instance + 1);
+            session.pluginStates[instance].assign(section.data + section.pos, section.data + size);
+        }
+        if (!section.ok) reader.ok = false;
+    }
+    munmap(mapped, info.st_size);
+
+    if (!reader.ok)
+    {
+        error = path + " is truncated or corrupt";
+        return false;
+    }
+    return true;
+}
+
+void applySessionParams(const Session& session, int instance, UiParams& params)
+{
+    if (instance < 0 || instance >= static_cast<int>(session.params.size())) return;
+    for (const auto& [name, value] : session.params[instance])
+    {
+        int id = UiParams::find(name);
+        if (id >= 0) params.set(id, value);
+    }
+}
@@ -0,0 +1,38 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "config.h"
+#include "globals.h"
+
+// ----------------------------------------------------------------------------------------------
+// Binary session snapshot: parameter values & plugin state of every instance, stream & recording settings
+    // "DSPS" + version, then tagged sections (4 char tag + uint32 size + payload), little endian
+    // unknown sections are skipped, so older builds can open newer sessions
+    // instance 0 is stored in PARM & PLUG, instances 1..N-1 in IPRM & IPLG sections prefixed with their index
+// ----------------------------------------------------------------------------------------------
+struct Session
+{
+    using Params = std::vector<std::pair<std::string, float>>; // by name, so reordering PARAMNAMES keeps sessions valid
+    std::vector<Params> params;                         // [instance], may hold fewer instances than are running
+    HostConfig stream;                                  // device, sampleRate, bufferFrames & recordDuration only
+    bool hasStream = false;
+    std::vector<std::vector<unsigned char>> pluginStates; // [instance], opaque blobs from saveStatePlugin(), may be empty
+};
+
+// gather the current host state, params[instance] & pluginStates (from PluginInstances::takeSnapshot())
+Session captureSession(const std::vector<const UiParams*>& params, const HostConfig& config, 
+                       const std::vector<std::vector<unsigned char>>& pluginStates);
+
+// written to a temporary file then renamed, so a crash never leaves a half written session
+bool saveSession(const std::string& path, const Session& session, std::string& error);
+
+// memory maps the file & parses it, false (with an empty error) if it doesn't exist
+bool loadSession(const std::string& path, Session& session, std::string& error);
+
+// apply an instance's saved parameter values, unknown names are ignored
+    // instances the session doesn't hold are left untouched
+void applySessionParams(const Session& session, int instance, UiParams& params);
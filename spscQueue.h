@@ -0,0 +1,46 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------------------------
+// Lock-free single producer / single consumer ring buffer, realtime safe on the consumer side
+    // push(items, count) publishes all items at once, so a consumer never sees half a batch
+// ----------------------------------------------------------------------------------------------
+template <typename T, std::uint32_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    public:
+        // producer thread only. All or nothing, false if there isn't room for every item
+        bool push(const T* items, std::uint32_t count)
+        {
+            const std::uint32_t write = _write.load(std::memory_order_relaxed);
+            const std::uint32_t read = _read.load(std::memory_order_acquire);
+            if (Capacity - (write - read) < count) return false;
+            for (std::uint32_t i = 0; i < count; i++) _items[(write + i) & (Capacity - 1)] = items[i];
+            _write.store(write + count, std::memory_order_release);
+            return true;
+        }
+        bool push(const T& item) { return push(&item, 1); }
+
+        // consumer thread only
+        bool pop(T& item)
+        {
+            const std::uint32_t read = _read.load(std::memory_order_relaxed);
+            if (read == _write.load(std::memory_order_acquire)) return false;
+            item = _items[read & (Capacity - 1)];
+            _read.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<T, Capacity> _items{};
+        alignas(64) std::atomic<std::uint32_t> _write = 0; // separate cache lines, so producer & consumer don't false share
+        alignas(64) std::atomic<std::uint32_t> _read = 0;
+};
@@ -12,6 +12,7 @@
 #include "ftxui/screen/color.hpp"
 
 #include <cmath>
+#include <cstdio>
 // #include <memory>
 #include <string>
 #include <utility>
@@ -83,6 +84,8 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     auto updateAtomicsCheckbox = [&](bool checkbox1, bool checkbox2, bool checkbox3, bool checkbox4)
     {
         uiParams.bypass = checkbox1;
+        uiParams.saturate = checkbox2;
+        uiParams.convolve = checkbox3;
     };
     auto updateAtomicsSlider = [&](float slider1, float slider2)
     {
@@ -101,15 +104,28 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
 
     // -- Toggles ---------------------------------------------------------------
     bool toggle1 = uiParams.bypass;
-    bool toggle2 = false;
-    bool toggle3 = false;
+    bool toggle2 = uiParams.saturate;
+    bool toggle3 = uiParams.convolve;
     bool toggle4 = false;
 
+    // the remote control server & sessions change uiParams too, so re-read them before every event & frame
+        // otherwise the next slider or checkbox event writes the stale local copies back
+    float sliderVal1 = uiParams.freq;
+    float sliderVal2 = uiParams.gain;
+    auto syncFromAtomics = [&]()
+    {
+        toggle1 = uiParams.bypass;
+        toggle2 = uiParams.saturate;
+        toggle3 = uiParams.convolve;
+        sliderVal1 = uiParams.freq;
+        sliderVal2 = uiParams.gain;
+    };
+
     auto toggles = Container::Horizontal(
     {
         Checkbox("bypass ", &toggle1),
-        Checkbox("toggle2 ", &toggle2),
-        Checkbox("toggle3 ", &toggle3),
+        Checkbox("saturate ", &toggle2),
+        Checkbox("convolve ", &toggle3),
         Checkbox("toggle4 ", &toggle4),
     });
 
@@ -117,6 +133,7 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     auto togglesCallback = ftxui::CatchEvent(toggles,
         [&](ftxui::Event event) 
         {
+            syncFromAtomics();
             bool handled = toggles->OnEvent(event);
             // If the event changed something, update shared atomic variables
             if (handled) { updateAtomicsCheckbox(toggle1, toggle2, toggle3, toggle4); }
@@ -136,6 +153,7 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
             std::thread wavWrite(wavWriteThread);
             wavWrite.detach(); // run independently
         }, ButtonOption::Ascii()) | xflex_grow,
+        Button("Save Session", [&] { globals.saveSession.store(1); }, ButtonOption::Ascii()) | xflex_grow,
         Button("Press Me", [&] { logTest(logBuff); }, ButtonOption::Ascii()) | xflex_grow,
         Button("Close", [&] { screen.Exit(); }, ButtonOption::Ascii()) | xflex_grow,
     });
@@ -143,8 +161,6 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     buttons = Wrap("Buttons", buttons);
 
     // -- Sliders -----------------------------------------------------------------
-    float sliderVal1 = uiParams.freq;
-    float sliderVal2 = uiParams.gain;
 
     SliderOption<float> slider1;
     slider1.value = &sliderVal1;
@@ -174,6 +190,7 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     auto slidersCallback = ftxui::CatchEvent(sliders,
         [&](ftxui::Event event) 
         {
+            syncFromAtomics();
             bool handled = sliders->OnEvent(event);
             // If the event changed something, update shared atomic variables
             if (handled) { updateAtomicsSlider(sliderVal1, sliderVal2); }
@@ -192,6 +209,23 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
         ) | dim;
     };
 
+    // stream settings & cost, for comparing sampleRates and block sizes
+    auto streamReadout = [&]()
+    {
+        char load[16];
+        snprintf(load, sizeof(load), "%.1f%%", globals.dspLoad.load() * 100.f);
+        char latency[16];
+        snprintf(latency, sizeof(latency), "%.1f ms", globals.latencyMs.load());
+        const int misses = globals.deadlineMisses.load();
+        if (globals.pluginTripped.load()) return text("PLUGIN OVERLOADED, save plugin.h to try again") | color(Color::Red);
+        return text(
+            std::to_string(globals.sampleRate.load()) + " Hz, "
+            + std::to_string(globals.bufferFrames.load()) + " frames, "
+            + latency + " latency, dsp: " + load
+            + (misses ? ", " + std::to_string(misses) + " late blocks" : "")
+        ) | dim;
+    };
+
     auto spacer = Spacer();
 
     auto braillePlot = Renderer([&] 
@@ -283,6 +317,7 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     });
 
     auto paramsTab = Renderer(layout, [&] {
+    syncFromAtomics();
     return vbox({
                 // separator(),
                 togglesCallback->Render(),
@@ -292,7 +327,11 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
                 buttons->Render(),
 
                 separator(),
-                sliderReadout(sliderVal1, sliderVal2),
+                hbox({
+                    sliderReadout(sliderVal1, sliderVal2),
+                    filler(),
+                    streamReadout(),
+                }),
 
                 separator(),
                 hbox({
@@ -376,4 +415,5 @@ void drawUi(LogBuffer& logBuff, Globals& globals, UiParams& uiParams)
     });
 
     screen.Loop(main_renderer);
+    globals.quitRequested.store(1); // the host saves the session & exits, so the next start sounds the same
 }
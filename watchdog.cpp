@@ -0,0 +1,205 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#include <algorithm>
+#include <pthread.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+#include "render.h"
+#include "rtCheck.h"
+#include "watchdog.h"
+
+PluginSlot::~PluginSlot()
+{
+    if (_worker.joinable())
+    {
+        _quit.store(true);
+        _start.release();
+        _worker.join();
+    }
+    instances.destroy();
+    closePluginModule(module);
+}
+
+void PluginSlot::startWorker()
+{
+    _buffer.assign(MAXBUFFERFRAMES * 2, 0.f);
+    _worker = std::thread([this] { workerLoop(); });
+}
+
+void PluginSlot::workerLoop()
+{
+    while (true)
+    {
+        _start.acquire();
+        if (_quit.load()) return;
+        const std::int64_t block = _posted.load(std::memory_order_relaxed);
+        {
+            AudioThreadScope audioThread; // the plugin runs here on the callback's behalf, RT_ALLOC_CHECK reports its allocations too
+            instances.process(_buffer.data(), _numFrames);
+        }
+        _finished.store(block, std::memory_order_release);
+        _done.release();
+    }
+}
+
+bool PluginSlot::process(float* out, int numFrames, std::chrono::steady_clock::time_point deadline)
+{
+    if (!idle()) return false; // still on a late block
+
+    // follow the callback's realtime scheduling (best effort, once), so ordinary threads can't make the worker late
+    if (!_prioritySet)
+    {
+        followCallerPriority();
+        _prioritySet = true;
+    }
+
+    _numFrames = numFrames;
+    const std::int64_t block = _posted.load(std::memory_order_relaxed) + 1;
+    _posted.store(block, std::memory_order_relaxed);
+    _start.release();
+
+    // wait for this block, skipping signals left by late ones. On timeout the worker keeps going & its output is dropped
+    while (_done.try_acquire_until(deadline))
+    {
+        if (_finished.load(std::memory_order_acquire) != block) continue;
+        std::copy_n(_buffer.data(), numFrames * 2, out);
+        return true;
+    }
+    return false;
+}
+
+bool PluginSlot::waitIdle(std::chrono::milliseconds timeout) const
+{
+    auto giveUp = std::chrono::steady_clock::now() + timeout;
+    while (!idle())
+    {
+        if (std::chrono::steady_clock::now() > giveUp) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void PluginSlot::retire(std::unique_ptr<PluginSlot> slot)
+{
+    if (slot && !slot->waitIdle(std::chrono::milliseconds(500)))
+    {
+        slot->demoteWorker();
+        slot.release(); // stuck, leak it
+    }
+}
+
+void PluginSlot::followCallerPriority()
+{
+#if defined(__APPLE__)
+    // CoreAudio's IO thread is Mach time constraint scheduled, which pthread priorities don't express
+        // the worker gets the same period, computation & constraint, there's no 1 step below with this policy
+        // a worker spinning forever is demoted by the kernel's overrun fail-safe, & by demoteWorker() on a trip
+    thread_time_constraint_policy_data_t policy;
+    mach_msg_type_number_t count = THREAD_TIME_CONSTRAINT_POLICY_COUNT;
+    boolean_t isDefault = false;
+    if (thread_policy_get(pthread_mach_thread_np(pthread_self()), THREAD_TIME_CONSTRAINT_POLICY, 
+                          reinterpret_cast<thread_policy_t>(&policy), &count, &isDefault) == KERN_SUCCESS && !isDefault)
+    {
+        thread_policy_set(pthread_mach_thread_np(_worker.native_handle()), THREAD_TIME_CONSTRAINT_POLICY, 
+                          reinterpret_cast<thread_policy_t>(&policy), THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+        return;
+    }
+#endif
+    // 1 step below a SCHED_FIFO / SCHED_RR callback, so a plugin spinning forever can't starve it
+    int policy;
+    sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && (policy == SCHED_FIFO || policy == SCHED_RR))
+    {
+        param.sched_priority = std::max(param.sched_priority - 1, sched_get_priority_min(policy));
+        pthread_setschedparam(_worker.native_handle(), policy, &param);
+    }
+}
+
+void PluginSlot::demoteWorker()
+{
+    if (!_worker.joinable()) return;
+#if defined(__APPLE__)
+    thread_standard_policy_data_t standard{};
+    thread_policy_set(pthread_mach_thread_np(_worker.native_handle()), THREAD_STANDARD_POLICY, 
+                      reinterpret_cast<thread_policy_t>(&standard), THREAD_STANDARD_POLICY_COUNT);
+#endif
+    sched_param param{};
+    pthread_setschedparam(_worker.native_handle(), SCHED_OTHER, &param);
+}
+
+void DeadlineWatchdog::process(PluginSlot* slot, float* out, int numFrames, std::chrono::steady_clock::time_point blockStart, Globals& globals)
+{
+    AudioThreadScope audioThread; // covers the inline paths below, whoever calls this
+    Source source = SILENCE;
+    const bool tripped = slot && slot->tripped.load(); // before this block, a trip below takes effect from the next one
+    if (slot && !tripped)
+    {
+        const float deadline = globals.deadline.load();
+        if (deadline <= 0.f) // watchdog off, process inline
+        {
+            if (slot->idle()) // unless it was only just switched off & a late block is still running
+            {
+                slot->instances.process(out, numFrames);
+                source = PLUGIN;
+            }
+        }
+        else
+        {
+            std::chrono::duration<float> budget(deadline * numFrames / globals.sampleRate.load());
+            if (slot->process(out, numFrames, blockStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget)))
+            {
+                slot->consecutiveMisses = 0;
+                source = PLUGIN;
+            }
+            else
+            {
+                globals.deadlineMisses.fetch_add(1);
+                if (++slot->consecutiveMisses >= globals.missLimit.load())
+                {
+                    slot->tripped.store(true);
+                    slot->demoteWorker(); // 1 syscall, once per trip, whilst it may still be spinning
+                    globals.pluginTripped.store(true);
+                    globals.pluginTrips.fetch_add(1); // the main thread logs it
+                }
+            }
+        }
+    }
+    // after a miss the deadline has passed, so the fallback only plays for builds that tripped in an earlier block
+        // & runs inline from the block's start
+    if (source != PLUGIN)
+    {
+        PluginSlot* fallback = tripped ? slot->fallback : nullptr;
+        if (fallback && !fallback->tripped.load() && fallback->idle())
+        {
+            fallback->instances.process(out, numFrames);
+            source = FALLBACK;
+        }
+        else std::fill_n(out, numFrames * 2, 0.f);
+    }
+
+    if (source != _source)
+    {
+        _source = source;
+        _fadePos = 0;
+    }
+    crossfade(out, numFrames);
+}
+
+void DeadlineWatchdog::crossfade(float* out, int numFrames)
+{
+    // from the held last frame of the old source to the new one
+    for (int i = 0; i < numFrames && _fadePos < FADEFRAMES; i++, _fadePos++)
+    {
+        const float gain = static_cast<float>(_fadePos + 1) / FADEFRAMES;
+        for (int ch = 0; ch < 2; ch++) out[2*i+ch] = _fadeFrom[ch] + gain * (out[2*i+ch] - _fadeFrom[ch]);
+    }
+    if (numFrames > 0)
+    {
+        _fadeFrom[0] = out[2 * (numFrames - 1) + 0];
+        _fadeFrom[1] = out[2 * (numFrames - 1) + 1];
+    }
+}
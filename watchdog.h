@@ -0,0 +1,86 @@
+// Copyright 2026 Reclaimed BCN. All rights reserved.
+// Use of this source code is governed by the license found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "globals.h"
+#include "instances.h"
+
+// ----------------------------------------------------------------------------------------------
+// A loaded plugin module & its instances, processed on their own worker thread so the audio
+// callback can stop waiting at a deadline. A plugin stuck in an infinite loop only takes out its worker
+// ----------------------------------------------------------------------------------------------
+class PluginSlot
+{
+    public:
+        PluginModule module{};
+        PluginInstances instances;
+        PluginSlot* fallback = nullptr;     // previous good version, processed inline once this one trips
+        std::atomic<bool> tripped = false;  // missed too many deadlines in a row, never processed again
+        int consecutiveMisses = 0;          // audio thread only
+
+        ~PluginSlot();
+        void startWorker();
+
+        // audio thread: hand 1 block to the worker & wait for it until deadline
+            // false if the worker is late (out is left untouched) or still busy with an earlier late block
+        bool process(float* out, int numFrames, std::chrono::steady_clock::time_point deadline);
+
+        // no late block in flight, so the instances can be processed inline
+        bool idle() const { return _finished.load(std::memory_order_acquire) == _posted.load(std::memory_order_relaxed); }
+
+        // wait up to timeout for a late block to finish, false if the worker seems stuck
+        bool waitIdle(std::chrono::milliseconds timeout) const;
+
+        // free the slot, unless its worker is stuck inside the plugin: then everything is leaked
+            // as the plugin's code & state can't be unloaded from under a running thread
+        static void retire(std::unique_ptr<PluginSlot> slot);
+
+        // drop the worker to normal scheduling, so a tripped build spinning forever only costs 1 ordinary thread
+        void demoteWorker();
+
+    private:
+        void workerLoop();
+        void followCallerPriority(); // from the audio thread, once
+
+        std::thread _worker;
+        std::binary_semaphore _start{0};
+        std::counting_semaphore<> _done{0};   // may hold signals of late blocks nobody waited for
+        std::atomic<std::int64_t> _posted = 0;   // blocks handed to the worker
+        std::atomic<std::int64_t> _finished = 0; // blocks the worker completed, behind _posted whilst busy
+        std::atomic<bool> _quit = false;
+        bool _prioritySet = false;
+        int _numFrames = 0;
+        std::vector<float> _buffer;         // worker output, only copied out when it's on time
+};
+
+// ----------------------------------------------------------------------------------------------
+// Per block deadline monitoring, run from the audio callback
+    // a block not done within globals.deadline of the block period is a miss & plays silence, there's no time left for anything else
+    // globals.missLimit misses in a row trips the plugin until it's reloaded, the fallback then plays inline from the next block
+    // switching between plugin, fallback & silence is crossfaded over a few ms so it doesn't click
+// ----------------------------------------------------------------------------------------------
+class DeadlineWatchdog
+{
+    public:
+        static constexpr int FADEFRAMES = 256;
+
+        // audio thread, never blocks past the deadline
+        void process(PluginSlot* slot, float* out, int numFrames, std::chrono::steady_clock::time_point blockStart, Globals& globals);
+
+    private:
+        enum Source { PLUGIN, FALLBACK, SILENCE };
+
+        void crossfade(float* out, int numFrames);
+
+        Source _source = SILENCE;
+        float _fadeFrom[2] = { 0.f, 0.f };  // last frame of the previous source, held & faded out
+        int _fadePos = FADEFRAMES;
+};
@@ -5,10 +5,14 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "globals.h"
+#include "wavEncoder.h"
 
 // for writing a specific number of bytes independent of system's int implementation
 void writeBytes(std::ofstream& file, int value, int size) 
@@ -18,6 +22,8 @@ void writeBytes(std::ofstream& file, int value, int size)
 
 void writeWav(Globals& globals, LogBuffer& logBuff) {
     logBuff.setNewLine("recording..");
+    const int sampleRate = globals.sampleRate.load();
+    const int recordFrames = globals.recordFrames();
     // setup
     std::ofstream audioFile;
     audioFile.open("recording.wav", std::ios::binary);
@@ -32,8 +38,8 @@ void writeWav(Globals& globals, LogBuffer& logBuff) {
     writeBytes(audioFile, 16, 4); // Size
     writeBytes(audioFile, 1, 2); // Compression code
     writeBytes(audioFile, 1, 2); // Number of channels
-    writeBytes(audioFile, SAMPLERATE, 4); // Sample rate
-    writeBytes(audioFile, SAMPLERATE * RECORDBITDEPTH  / BYTETOBITS, 4 ); // Byte rate
+    writeBytes(audioFile, sampleRate, 4); // Sample rate
+    writeBytes(audioFile, sampleRate * RECORDBITDEPTH  / BYTETOBITS, 4 ); // Byte rate
     writeBytes(audioFile, RECORDBITDEPTH / 8, 2); // Block align
     writeBytes(audioFile, RECORDBITDEPTH , 2); // Bit depth
 
@@ -46,9 +52,9 @@ void writeWav(Globals& globals, LogBuffer& logBuff) {
     // SAMPLE WRITING
         // scale float samples to unsigned int for writing to .wav file
     auto maxAmplitude = pow(2, RECORDBITDEPTH  - 1) - 1;
-        // circular buffer readHead, 1 buffer ahead of writeHead
-    std::size_t readHead = (globals.writeHead.load() + BUFFERFRAMES) % globals.circularOutput.size();
-    for(int i = 0; i < RECORDFRAMES; i++ ) 
+        // circular buffer readHead, recordFrames behind writeHead (the buffer's spare room keeps the writer off it)
+    std::size_t readHead = (globals.writeHead.load() + globals.circularOutput.size() - recordFrames) % globals.circularOutput.size();
+    for(int i = 0; i < recordFrames; i++ ) 
     {
         globals.wavWriteFloats[i] = globals.circularOutput[readHead];
         readHead = (readHead + 1) % globals.circularOutput.size();
@@ -71,6 +77,99 @@ void writeWav(Globals& globals, LogBuffer& logBuff) {
     audioFile.close();
 
     logBuff.setNewLine("recording saved!");
-    logBuff.setNewLine("recording.wav = " + std::to_string(RECORDDURATION) + " seconds");
+    logBuff.setNewLine("recording.wav = " + std::to_string(globals.recordDuration) + " seconds");
 }
 
+
+bool writeWavFile(const std::string& path, const std::vector<float>& samples, int numChannels, int sampleRate)
+{
+    std::ofstream audioFile(path, std::ios::binary);
+    if (!audioFile.is_open()) return false;
+    const int bytesPerSample = sizeof(float);
+    const int dataSize = static_cast<int>(samples.size()) * bytesPerSample;
+
+    // header chunk
+    audioFile << "RIFF";
+    writeBytes(audioFile, 36 + dataSize, 4); // size of wav file minus 8 bytes
+    audioFile << "WAVE";
+
+    // format chunk
+    audioFile << "fmt ";
+    writeBytes(audioFile, 16, 4); // Size
+    writeBytes(audioFile, 3, 2); // Compression code, IEEE float
+    writeBytes(audioFile, numChannels, 2); // Number of channels
+    writeBytes(audioFile, sampleRate, 4); // Sample rate
+    writeBytes(audioFile, sampleRate * numChannels * bytesPerSample, 4); // Byte rate
+    writeBytes(audioFile, numChannels * bytesPerSample, 2); // Block align
+    writeBytes(audioFile, bytesPerSample * BYTETOBITS, 2); // Bit depth
+
+    // data chunk
+    audioFile << "data";
+    writeBytes(audioFile, dataSize, 4);
+    audioFile.write(reinterpret_cast<const char*>(samples.data()), dataSize); // little endian hosts only, like writeBytes()
+    return audioFile.good();
+}
+
+// read a little endian integer of 'size' bytes from a byte buffer
+static int readBytes(const unsigned char* bytes, int size)
+{
+    unsigned int value = 0;
+    for (int i = 0; i < size; i++) value |= static_cast<unsigned int>(bytes[i]) << (8 * i);
+    if (size < 4 && (value & (1u << (8 * size - 1)))) value |= ~0u << (8 * size); // sign extend
+    return static_cast<int>(value);
+}
+
+bool readWav(const std::string& path, std::vector<float>& samples, int& numChannels, int& sampleRate)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::string(bytes.begin(), bytes.begin() + 4) != "RIFF" || std::string(bytes.begin() + 8, bytes.begin() + 12) != "WAVE") return false;
+
+    int format = 0;
+    int bitDepth = 0;
+    numChannels = 0;
+    // walk the chunks, skipping any we don't need (LIST, fact, ..)
+    std::size_t pos = 12;
+    while (pos + 8 <= bytes.size())
+    {
+        std::string id(bytes.begin() + pos, bytes.begin() + pos + 4);
+        std::size_t size = static_cast<unsigned int>(readBytes(&bytes[pos + 4], 4));
+        std::size_t start = pos + 8;
+        if (start + size > bytes.size()) size = bytes.size() - start; // tolerate truncated files
+
+        if (id == "fmt " && size >= 16)
+        {
+            format = readBytes(&bytes[start], 2);
+            numChannels = readBytes(&bytes[start + 2], 2);
+            sampleRate = readBytes(&bytes[start + 4], 4);
+            bitDepth = readBytes(&bytes[start + 14], 2);
+            if (format == 0xFFFE && size >= 26) format = readBytes(&bytes[start + 24], 2); // WAVE_FORMAT_EXTENSIBLE sub format
+        }
+        else if (id == "data" && numChannels > 0)
+        {
+            const bool isFloat = format == 3 && bitDepth == 32;
+            const bool isPcm = format == 1 && (bitDepth == 16 || bitDepth == 24 || bitDepth == 32);
+            if (!isFloat && !isPcm) return false;
+
+            const int bytesPerSample = bitDepth / BYTETOBITS;
+            const float scale = 1.f / static_cast<float>(1u << (bitDepth - 1));
+            samples.resize(size / bytesPerSample);
+            for (std::size_t i = 0; i < samples.size(); i++)
+            {
+                int value = readBytes(&bytes[start + i * bytesPerSample], bytesPerSample);
+                if (isFloat)
+                {
+                    float floatValue;
+                    std::memcpy(&floatValue, &value, sizeof(float));
+                    samples[i] = floatValue;
+                }
+                else samples[i] = value * scale;
+            }
+            samples.resize(samples.size() - samples.size() % numChannels); // whole frames only
+            return true;
+        }
+        pos = start + size + (size & 1); // chunks are padded to an even size
+    }
+    return false;
+}
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <fstream>
+#include <string>
+#include <vector>
 #include "globals.h"
 
 void writeBytes(std::ofstream& file, int value, int size);
 void writeWav(Globals& globals, LogBuffer& logBuff);
 void wavWriteThread();
+// write interleaved floats as a 32 bit float .wav file, lossless so renders can be compared bit for bit
+bool writeWavFile(const std::string& path, const std::vector<float>& samples, int numChannels, int sampleRate);
+// read a PCM (16/24/32 bit) or 32 bit float .wav file into interleaved floats, false if unreadable/unsupported
+bool readWav(const std::string& path, std::vector<float>& samples, int& numChannels, int& sampleRate);